@@ -20,6 +20,10 @@ void AFINModuleScreen::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Out
 
 void AFINModuleScreen::BeginPlay() {
 	Super::BeginPlay();
+
+	SlateWidget.SignificanceDistance = SignificanceDistance;
+	SlateWidget.Register(WidgetComponent);
+	SlateWidget.SetContent(Widget);
 	
 	if (HasAuthority()) GPUPtr = GPU.Get();
 	if (GPUPtr) Cast<IFINGPUInterface>(GPUPtr)->RequestNewWidget();
@@ -28,6 +32,7 @@ void AFINModuleScreen::BeginPlay() {
 void AFINModuleScreen::EndPlay(const EEndPlayReason::Type endPlayReason) {
 	Super::EndPlay(endPlayReason);
 	if (endPlayReason == EEndPlayReason::Destroyed) BindGPU(FFINNetworkTrace());
+	SlateWidget.Unregister();
 }
 
 void AFINModuleScreen::Tick(float DeltaSeconds) {
@@ -58,15 +63,7 @@ FFINNetworkTrace AFINModuleScreen::GetGPU() const {
 
 void AFINModuleScreen::SetWidget(TSharedPtr<SWidget> widget) {
 	if (Widget != widget) Widget = widget;
-	WidgetComponent->SetSlateWidget(
-		Widget.IsValid() ?
-			SNew(SScaleBox)
-			.Stretch(EStretch::ScaleToFit)
-			.Content()[
-				Widget.ToSharedRef()
-			]
-		:
-			TSharedPtr<SScaleBox>(nullptr));
+	SlateWidget.SetContent(Widget);
 	OnWidgetUpdate.Broadcast();
 }
 
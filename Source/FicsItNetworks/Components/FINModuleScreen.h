@@ -3,6 +3,7 @@
 #include "FINModuleBase.h"
 #include "WidgetComponent.h"
 #include "Computer/FINComputerScreen.h"
+#include "Graphics/FINScreenSlateWidget.h"
 #include "FINModuleScreen.generated.h"
 
 UCLASS()
@@ -14,6 +15,8 @@ private:
 
 	UPROPERTY(Replicated)
 	UObject* GPUPtr = nullptr;
+
+	FFINScreenSlateWidget SlateWidget;
 	
 public:
     TSharedPtr<SWidget> Widget;
@@ -21,6 +24,12 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
 	UWidgetComponent* WidgetComponent;
 
+	/**
+	 * The distance after which the screen gets redrawn less often
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	float SignificanceDistance = 3000.0f;
+
 	/**
 	* This event gets triggered when a new widget got set by the GPU
 	*/
@@ -2,6 +2,18 @@
 #include "Network/FINAdvancedNetworkConnectionComponent.h"
 #include "Network/FINNetworkCircuit.h"
 
+namespace {
+	/**
+	 * The routers currently resolving group members on this thread, used to break router cycles.
+	 */
+	thread_local TArray<const AFINNetworkRouter*> ResolvingRouters;
+
+	/**
+	 * Set if a group member resolve hit a router cycle, the result then is not allowed to get cached.
+	 */
+	thread_local bool bGroupResolveIncomplete = false;
+}
+
 AFINNetworkRouter::AFINNetworkRouter() {
 	NetworkConnector1 = CreateDefaultSubobject<UFINAdvancedNetworkConnectionComponent>("NetworkConnector1");
 	NetworkConnector1->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
@@ -17,28 +29,47 @@ AFINNetworkRouter::~AFINNetworkRouter() {}
 void AFINNetworkRouter::BeginPlay() {
 	Super::BeginPlay();
 
+	UpdatePortFilter();
+	UpdateAddrFilter();
+
 	NetworkConnector1->OnIsNetworkRouter.BindLambda([]() {
         return true;
     });
 	NetworkConnector1->OnIsNetworkPortOpen.BindLambda([this](int Port) {
-        return PortList.Contains(Port) == bIsPortWhitelist;
+        return IsPortAllowed(Port);
     });
-	NetworkConnector1->OnNetworkMessageRecieved.AddLambda([this](FGuid ID, FGuid Sender, FGuid Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data) {
+	NetworkConnector1->OnNetworkMessageRecieved.AddLambda([this](FGuid ID, FGuid Sender, FGuid Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data, const FFINNetworkMessageRouting& Routing) {
         this->LampFlags |= FIN_NetRouter_Con1_Tx;
-        if (HandleMessage(IFINNetworkCircuitNode::Execute_GetCircuit(NetworkConnector2), ID, Sender, Reciever, Port, Data))
+        if (HandleMessage(NetworkConnector1, NetworkConnector2, ID, Sender, Reciever, Port, Data, Routing))
         	this->LampFlags |= FIN_NetRouter_Con2_Rx;
     });
+	NetworkConnector1->OnIsInNetworkGroup.BindLambda([this](int Group) {
+		TArray<UObject*> Members;
+		GetGroupMembers(NetworkConnector2, Group, Members);
+		return Members.Num() > 0;
+	});
+	NetworkConnector1->OnNetworkUpdated.AddLambda([this](int Type, const TSet<UObject*>& Nodes) {
+		ClearRoutes();
+	});
 	NetworkConnector2->OnIsNetworkRouter.BindLambda([]() {
         return true;
     });
 	NetworkConnector2->OnIsNetworkPortOpen.BindLambda([this](int Port) {
-        return PortList.Contains(Port) == bIsPortWhitelist;
+        return IsPortAllowed(Port);
     });
-	NetworkConnector2->OnNetworkMessageRecieved.AddLambda([this](FGuid ID, FGuid Sender, FGuid Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data) {
+	NetworkConnector2->OnNetworkMessageRecieved.AddLambda([this](FGuid ID, FGuid Sender, FGuid Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data, const FFINNetworkMessageRouting& Routing) {
         this->LampFlags |= FIN_NetRouter_Con2_Tx;
-        if (HandleMessage(IFINNetworkCircuitNode::Execute_GetCircuit(NetworkConnector1), ID, Sender, Reciever, Port, Data))
+        if (HandleMessage(NetworkConnector2, NetworkConnector1, ID, Sender, Reciever, Port, Data, Routing))
 	        this->LampFlags |= FIN_NetRouter_Con1_Rx;
     });
+	NetworkConnector2->OnIsInNetworkGroup.BindLambda([this](int Group) {
+		TArray<UObject*> Members;
+		GetGroupMembers(NetworkConnector1, Group, Members);
+		return Members.Num() > 0;
+	});
+	NetworkConnector2->OnNetworkUpdated.AddLambda([this](int Type, const TSet<UObject*>& Nodes) {
+		ClearRoutes();
+	});
 }
 
 void AFINNetworkRouter::Tick(float DeltaSeconds) {
@@ -52,33 +83,166 @@ void AFINNetworkRouter::Tick(float DeltaSeconds) {
 	}
 }
 
-bool AFINNetworkRouter::HandleMessage(AFINNetworkCircuit* SendingCircuit, FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data) {
+void AFINNetworkRouter::PostLoadGame_Implementation(int32 saveVersion, int32 gameVersion) {
+	UpdatePortFilter();
+	UpdateAddrFilter();
+}
+
+bool AFINNetworkRouter::IsPortAllowed(int Port) const {
+	bool bInList = PortFilter.IsValidIndex(Port) && PortFilter[Port];
+	return bInList == bIsPortWhitelist;
+}
+
+bool AFINNetworkRouter::IsAddrAllowed(const FGuid& Sender) const {
+	return AddrFilter.Contains(Sender) == bIsAddrWhitelist;
+}
+
+void AFINNetworkRouter::UpdatePortFilter() {
+	int MaxListedPort = -1;
+	for (int Port : PortList) if (Port <= MaxPort) MaxListedPort = FMath::Max(MaxListedPort, Port);
+	PortFilter.Init(false, MaxListedPort + 1);
+	for (int Port : PortList) if (Port >= 0 && Port <= MaxPort) PortFilter[Port] = true;
+}
+
+void AFINNetworkRouter::UpdateAddrFilter() {
+	AddrFilter.Empty(AddrList.Num());
+	for (const FString& Addr : AddrList) {
+		FGuid Guid;
+		if (FGuid::Parse(Addr, Guid)) AddrFilter.Add(Guid);
+	}
+}
+
+void AFINNetworkRouter::LearnRoute(UFINAdvancedNetworkConnectionComponent* From, const FGuid& Sender, UObject* PreviousHop) {
+	if (Routes.Num() >= MaxRoutes && !Routes.Contains(Sender)) Routes.Empty();
+	FFINNetworkRoute& Route = Routes.FindOrAdd(Sender);
+	Route.Connector = From;
+	UFINNetworkCircuit* Circuit = IFINNetworkCircuitNode::Execute_GetCircuit(From);
+	Route.Circuit = Circuit;
+	Route.CircuitID = Circuit ? Circuit->GetCircuitID() : 0;
+	Route.NextHop = PreviousHop;
+	Route.LearnedAt = FPlatformTime::Seconds();
+}
+
+bool AFINNetworkRouter::FindRoute(const FGuid& Receiver, FFINNetworkRoute& OutRoute) {
+	FFINNetworkRoute* Route = Routes.Find(Receiver);
+	if (!Route) return false;
+	// routes learned in a circuit which changed since then, or not confirmed for a while, are not trustworthy anymore
+	UFINNetworkCircuit* Circuit = Route->Circuit.Get();
+	UObject* NextHop = Route->NextHop.Get();
+	if (FPlatformTime::Seconds() - Route->LearnedAt > RouteTimeout || !Circuit || Circuit->GetCircuitID() != Route->CircuitID || IFINNetworkCircuitNode::Execute_GetCircuit(Route->Connector) != Circuit || Route->NextHop.IsStale() || (NextHop && IFINNetworkCircuitNode::Execute_GetCircuit(NextHop) != Circuit)) {
+		Routes.Remove(Receiver);
+		return false;
+	}
+	OutRoute = *Route;
+	return true;
+}
+
+void AFINNetworkRouter::ClearRoutes() {
+	FScopeLock Lock(&HandleMessageMutex);
+	Routes.Empty();
+}
+
+void AFINNetworkRouter::GetGroupMembers(UFINAdvancedNetworkConnectionComponent* Connector, int Group, TArray<UObject*>& OutMembers) {
+	TMap<int, FFINNetworkGroupMembers>& Cache = (Connector == NetworkConnector1) ? GroupMembers1 : GroupMembers2;
+	int32 Epoch = IFINNetworkMessageInterface::GetGroupEpoch();
+	{
+		FScopeLock Lock(&GroupMembersMutex);
+		FFINNetworkGroupMembers* Members = Cache.Find(Group);
+		if (Members && Members->Epoch == Epoch) {
+			for (const TWeakObjectPtr<UObject>& Member : Members->Members) {
+				if (UObject* Obj = Member.Get()) OutMembers.Add(Obj);
+			}
+			return;
+		}
+	}
+
+	// a router asking itself again means the networks form a cycle, the other path already gets searched
+	if (ResolvingRouters.Contains(this)) {
+		bGroupResolveIncomplete = true;
+		return;
+	}
+	UFINNetworkCircuit* Circuit = IFINNetworkCircuitNode::Execute_GetCircuit(Connector);
+	if (!Circuit) return;
+	
+	ResolvingRouters.Push(this);
+	bool bOuterIncomplete = bGroupResolveIncomplete;
+	bGroupResolveIncomplete = false;
+	FFINNetworkGroupMembers Members;
+	Members.Epoch = Epoch;
+	for (UObject* Component : Circuit->GetComponents()) {
+		IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(Component);
+		if (Component == Connector || !MsgI || !MsgI->IsInGroup(Group)) continue;
+		Members.Members.Add(Component);
+		OutMembers.Add(Component);
+	}
+	ResolvingRouters.Pop();
+	if (!bGroupResolveIncomplete) {
+		FScopeLock Lock(&GroupMembersMutex);
+		Cache.Add(Group, MoveTemp(Members));
+	}
+	bGroupResolveIncomplete |= bOuterIncomplete;
+}
+
+bool AFINNetworkRouter::HandleMessage(UFINAdvancedNetworkConnectionComponent* From, UFINAdvancedNetworkConnectionComponent* To, FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data, const FFINNetworkMessageRouting& Routing) {
+	UFINNetworkCircuit* SendingCircuit = IFINNetworkCircuitNode::Execute_GetCircuit(To);
+	FFINNetworkRoute Route;
+	bool bHasRoute = false;
 	{
 		FScopeLock Lock(&HandleMessageMutex);
 		if (HandledMessages.Contains(ID) || !SendingCircuit) return false;
 		HandledMessages.Add(ID);
+		LearnRoute(From, Sender, Routing.PreviousHop);
+		if (Receiver.IsValid()) bHasRoute = FindRoute(Receiver, Route);
 	}
-	if (AddrList.Contains(Sender.ToString()) != bIsAddrWhitelist) return false;
+	if (Routing.HopLimit <= 0) return false;
+	if (!IsAddrAllowed(Sender)) return false;
+	
+	FFINNetworkMessageRouting NextRouting = Routing;
+	NextRouting.HopLimit -= 1;
+	NextRouting.PreviousHop = To;
 	bool bSent = false;
-	if (Receiver.IsValid()) {
+	if (Routing.Group >= 0) {
+		TArray<UObject*> Members;
+		GetGroupMembers(To, Routing.Group, Members);
+		for (UObject* Member : Members) {
+			IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(Member);
+			if (!MsgI || !MsgI->IsPortOpen(Port)) continue;
+			MsgI->HandleMessage(ID, Sender, Receiver, Port, Data, NextRouting);
+			bSent = true;
+		}
+	} else if (Receiver.IsValid()) {
+		if (bHasRoute) {
+			// the receiver is located on the side the message came from
+			if (Route.Connector == From) return false;
+			// if the next hop doesn't take the message anymore, the route is broken and the message gets flooded instead
+			IFINNetworkMessageInterface* NextHop = Cast<IFINNetworkMessageInterface>(Route.NextHop.Get());
+			if (NextHop && NextHop->IsPortOpen(Port)) {
+				NextHop->HandleMessage(ID, Sender, Receiver, Port, Data, NextRouting);
+				return true;
+			}
+			if (NextHop) {
+				FScopeLock Lock(&HandleMessageMutex);
+				Routes.Remove(Receiver);
+			}
+		}
 		UObject* Obj = SendingCircuit->FindComponent(Receiver, nullptr).GetObject();
 		IFINNetworkMessageInterface* NetMsgI = Cast<IFINNetworkMessageInterface>(Obj);
 		if (NetMsgI && NetMsgI->IsPortOpen(Port)) {
-			NetMsgI->HandleMessage(ID, Sender, Receiver, Port, Data);
+			NetMsgI->HandleMessage(ID, Sender, Receiver, Port, Data, NextRouting);
 			bSent = true;
 		} else if (!NetMsgI) {
 			for (UObject* Router : SendingCircuit->GetComponents()) {
 				IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(Router);
-				if (!MsgI || !MsgI->IsNetworkMessageRouter() || !MsgI->IsPortOpen(Port)) continue;
-				MsgI->HandleMessage(ID, Sender, Receiver, Port, Data);
+				if (!MsgI || !MsgI->IsNetworkMessageRouter() || !MsgI->IsPortOpen(Port) || Router == To) continue;
+				MsgI->HandleMessage(ID, Sender, Receiver, Port, Data, NextRouting);
 				bSent = true;
 			}
 		}
 	} else {
 		for (UObject* MsgHandler : SendingCircuit->GetComponents()) {
 			IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(MsgHandler);
-			if (!MsgI || !MsgI->IsPortOpen(Port)) continue;
-			MsgI->HandleMessage(ID, Sender, Receiver, Port, Data);
+			if (!MsgI || !MsgI->IsPortOpen(Port) || MsgHandler == To) continue;
+			MsgI->HandleMessage(ID, Sender, Receiver, Port, Data, NextRouting);
 			bSent = true;
 		}
 	}
@@ -109,15 +273,19 @@ bool AFINNetworkRouter::netPropGet_isWhitelist() {
 }
 
 void AFINNetworkRouter::netFunc_addPortList(int port) {
+	if (port < 0 || port > MaxPort) return;
 	PortList.AddUnique(port);
+	UpdatePortFilter();
 }
 
 void AFINNetworkRouter::netFunc_removePortList(int port) {
 	PortList.Remove(port);
+	UpdatePortFilter();
 }
 
 void AFINNetworkRouter::netFunc_setPortList(const TArray<int>& portList) {
 	PortList = portList;
+	UpdatePortFilter();
 }
 
 TArray<int> AFINNetworkRouter::netFunc_getPortList() {
@@ -134,14 +302,17 @@ bool AFINNetworkRouter::netPropGet_isAddrWhitelist() {
 
 void AFINNetworkRouter::netFunc_addAddrList(const FString& addr) {
 	AddrList.AddUnique(addr);
+	UpdateAddrFilter();
 }
 
 void AFINNetworkRouter::netFunc_removeAddrList(const FString& addr) {
 	AddrList.Remove(addr);
+	UpdateAddrFilter();
 }
 
 void AFINNetworkRouter::netFunc_setAddrList(const TArray<FString>& list) {
 	AddrList = list;
+	UpdateAddrFilter();
 }
 
 TArray<FString> AFINNetworkRouter::netFunc_getAddrList() {
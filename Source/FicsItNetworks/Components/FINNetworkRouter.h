@@ -17,6 +17,56 @@ enum EFINNetworkRouterLampFlags {
 };
 ENUM_CLASS_FLAGS(EFINNetworkRouterLampFlags);
 
+/**
+ * A learned route of a network router to a network component.
+ */
+struct FFINNetworkRoute {
+	/**
+	 * The connector of the router on whose side the component is located.
+	 */
+	UFINAdvancedNetworkConnectionComponent* Connector = nullptr;
+
+	/**
+	 * The circuit the connector was part of when the route got learned.
+	 * The route is only valid as long as the connector is still part of this circuit.
+	 */
+	TWeakObjectPtr<UFINNetworkCircuit> Circuit;
+
+	/**
+	 * The id the circuit had when the route got learned.
+	 * Circuit objects get pooled and reused, so the id tells if it is still the same circuit.
+	 */
+	int32 CircuitID = 0;
+
+	/**
+	 * The router connector in the circuit which leads to the component.
+	 * Not valid if the component is directly part of the circuit.
+	 */
+	TWeakObjectPtr<UObject> NextHop;
+
+	/**
+	 * The time in seconds at which the route got learned or confirmed the last time.
+	 * Changes in the circuits behind the next hop are not visible to the router, so routes have to age out.
+	 */
+	double LearnedAt = 0.0;
+};
+
+/**
+ * The cached members of a multicast group on one side of a network router.
+ */
+struct FFINNetworkGroupMembers {
+	/**
+	 * The group epoch at which the members got resolved.
+	 */
+	int32 Epoch = -1;
+
+	/**
+	 * The message handlers of the circuit which are interested in the group,
+	 * including routers with group members on their other side.
+	 */
+	TArray<TWeakObjectPtr<UObject>> Members;
+};
+
 UCLASS()
 class AFINNetworkRouter : public AFGBuildable {
 	GENERATED_BODY()
@@ -41,9 +91,53 @@ public:
 	TArray<FString> AddrList;
 
 	UPROPERTY()
-	TArray<FGuid> HandledMessages;
+	TSet<FGuid> HandledMessages;
 	FCriticalSection HandleMessageMutex;
 
+	/**
+	 * The highest port network messages can be sent on.
+	 * Ports above can't be part of the port filter, so the bitmap stays small.
+	 */
+	static constexpr int MaxPort = 10000;
+
+	/**
+	 * Bitmap of the ports contained in the port filter list.
+	 * Gets rebuilt from the port list whenever it changes, ports outside of 0 to MaxPort get ignored.
+	 */
+	TBitArray<> PortFilter;
+
+	/**
+	 * Set of the parsed addresses contained in the address filter list.
+	 * Gets rebuilt from the address list whenever it changes.
+	 */
+	TSet<FGuid> AddrFilter;
+
+	/**
+	 * Routes to network components learned from the senders of the messages passing the router.
+	 * A route gets forgotten once the circuit it got learned in or the circuit of its next hop changes,
+	 * or if it times out.
+	 */
+	TMap<FGuid, FFINNetworkRoute> Routes;
+
+	/**
+	 * The time in seconds after which a route not confirmed by a message of the component gets forgotten.
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	float RouteTimeout = 30.0f;
+
+	/**
+	 * The max amount of routes the router keeps, if exceeded all routes get forgotten.
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	int MaxRoutes = 4096;
+
+	/**
+	 * Cached multicast group members in the circuits of the connectors.
+	 */
+	TMap<int, FFINNetworkGroupMembers> GroupMembers1;
+	TMap<int, FFINNetworkGroupMembers> GroupMembers2;
+	FCriticalSection GroupMembersMutex;
+
 	EFINNetworkRouterLampFlags LampFlags;
 
 	AFINNetworkRouter();
@@ -53,6 +147,20 @@ public:
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaSeconds) override;
 	// End AActor
+
+	// Begin IFGSaveInterface
+	virtual void PostLoadGame_Implementation(int32 saveVersion, int32 gameVersion) override;
+	// End IFGSaveInterface
+
+	/**
+	 * Checks if messages on the given port are allowed to pass the port filter.
+	 */
+	bool IsPortAllowed(int Port) const;
+
+	/**
+	 * Checks if messages of the given sender are allowed to pass the address filter.
+	 */
+	bool IsAddrAllowed(const FGuid& Sender) const;
 	
 	UFUNCTION()
     void netClass_Meta(FString& InternalName, FText& DisplayName, TMap<FString, FString>& PropertyInternalNames, TMap<FString, FText>& PropertyDisplayNames, TMap<FString, FText>& PropertyDescriptions, TMap<FString, int32>& PropertyRuntimes) {
@@ -183,7 +291,20 @@ public:
     void OnMessageHandled(bool bCon1or2, bool bSendOrReceive);
 	
 private:
-	bool HandleMessage(AFINNetworkCircuit* SendingCircuit, FGuid ID, FGuid Sender, FGuid Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data);
+	void UpdatePortFilter();
+	void UpdateAddrFilter();
+
+	void LearnRoute(UFINAdvancedNetworkConnectionComponent* From, const FGuid& Sender, UObject* PreviousHop);
+	bool FindRoute(const FGuid& Receiver, FFINNetworkRoute& OutRoute);
+	void ClearRoutes();
+
+	/**
+	 * Collects the members of the given multicast group in the circuit of the given connector.
+	 * Uses the cached members if the group epoch did not change since they got resolved.
+	 */
+	void GetGroupMembers(UFINAdvancedNetworkConnectionComponent* Connector, int Group, TArray<UObject*>& OutMembers);
+
+	bool HandleMessage(UFINAdvancedNetworkConnectionComponent* From, UFINAdvancedNetworkConnectionComponent* To, FGuid ID, FGuid Sender, FGuid Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data, const FFINNetworkMessageRouting& Routing);
 
 	UFUNCTION(NetMulticast, Unreliable)
     void NetMulti_OnMessageHandled(EFINNetworkRouterLampFlags Flags);
@@ -45,6 +45,9 @@ void AFINScreen::BeginPlay() {
 	}
 	WidgetComponent->AddRelativeLocation(WidgetOffset);
 	WidgetComponent->SetDrawSize(WidgetComponent->GetDrawSize() * FVector2D(FMath::Abs(ScreenWidth), FMath::Abs(ScreenHeight)));
+	SlateWidget.SignificanceDistance = SignificanceDistance * FMath::Max(FMath::Abs(ScreenWidth), FMath::Abs(ScreenHeight));
+	SlateWidget.Register(WidgetComponent);
+	SlateWidget.SetContent(Widget);
 
 	if (HasAuthority()) GPUPtr = GPU.Get();
 	if (GPUPtr) Cast<IFINGPUInterface>(GPUPtr)->RequestNewWidget();
@@ -90,6 +93,7 @@ void AFINScreen::Tick(float DeltaSeconds) {
 void AFINScreen::EndPlay(const EEndPlayReason::Type endPlayReason) {
 	Super::EndPlay(endPlayReason);
 	if (endPlayReason == EEndPlayReason::Destroyed) BindGPU(FFINNetworkTrace());
+	SlateWidget.Unregister();
 }
 
 int32 AFINScreen::GetDismantleRefundReturnsMultiplier() const {
@@ -122,17 +126,7 @@ FFINNetworkTrace AFINScreen::GetGPU() const {
 
 void AFINScreen::SetWidget(TSharedPtr<SWidget> widget) {
 	if (Widget != widget) Widget = widget;
-	WidgetComponent->SetSlateWidget(
-		Widget.IsValid() ?
-			SNew(SScaleBox)
-			.Stretch(EStretch::ScaleToFit)
-			.Content()[
-				Widget.ToSharedRef()
-			]
-		:
-			SNew(SScaleBox)
-		);
-	WidgetComponent->RequestRedraw();
+	SlateWidget.SetContent(Widget);
 	OnWidgetUpdate.Broadcast();
 }
 
@@ -161,7 +155,7 @@ void AFINScreen::NetMulti_OnGPUUpdate_Implementation() {
 	if (GPUPtr) {
 		Cast<IFINGPUInterface>(GPUPtr)->RequestNewWidget();
 	} else {
-		SetWidget(SNew(SScaleBox));
+		SetWidget(nullptr);
 	}
 	OnGPUUpdate.Broadcast();
 }
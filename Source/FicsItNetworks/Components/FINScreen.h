@@ -4,6 +4,7 @@
 #include "WidgetComponent.h"
 #include "Computer/FINComputerScreen.h"
 #include "Graphics/FINScreenInterface.h"
+#include "Graphics/FINScreenSlateWidget.h"
 #include "Network/FINAdvancedNetworkConnectionComponent.h"
 #include "FINScreen.generated.h"
 
@@ -17,6 +18,8 @@ private:
 
 	UPROPERTY(Replicated)
 	UObject* GPUPtr = nullptr;
+
+	FFINScreenSlateWidget SlateWidget;
 	
 public:
 	TSharedPtr<SWidget> Widget;
@@ -36,6 +39,12 @@ public:
 	UPROPERTY(EditDefaultsOnly)
 	UStaticMesh* ScreenCorner = nullptr;
 
+	/**
+	 * The distance after which the screen gets redrawn less often
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	float SignificanceDistance = 5000.0f;
+
 	UPROPERTY(SaveGame, Replicated)
 	int ScreenWidth = 1;
 
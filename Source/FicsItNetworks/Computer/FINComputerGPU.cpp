@@ -49,6 +49,7 @@ void AFINComputerGPU::TickActor(float DeltaTime, ELevelTick TickType, FActorTick
 void AFINComputerGPU::EndPlay(const EEndPlayReason::Type endPlayReason) {
 	Super::EndPlay(endPlayReason);
 	if (endPlayReason == EEndPlayReason::Destroyed) BindScreen(FFINNetworkTrace());
+	Widget.Reset();
 }
 
 void AFINComputerGPU::BindScreen(const FFINNetworkTrace& screen) {
@@ -74,7 +75,6 @@ void AFINComputerGPU::RequestNewWidget() {
 }
 
 void AFINComputerGPU::DropWidget() {
-	Widget.Reset();
 	if (ScreenPtr) Cast<IFINScreenInterface>(ScreenPtr)->SetWidget(nullptr);
 }
 
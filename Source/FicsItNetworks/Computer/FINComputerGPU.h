@@ -15,6 +15,10 @@ protected:
 	UPROPERTY(Replicated)
 	UObject* ScreenPtr = nullptr;
 
+	/**
+	 * The widget created by this GPU.
+	 * Stays cached when the screen drops the widget, so it can get reused for the next screen.
+	 */
 	TSharedPtr<SWidget> Widget;
 	bool bShouldCreate = false;
 	bool bScreenChanged = false;
@@ -8,11 +8,120 @@
 #include "WidgetBlueprintLibrary.h"
 #include "WidgetLayoutLibrary.h"
 #include "FicsItNetworks/Graphics/FINScreenInterface.h"
+#include "FicsItNetworksModule.h"
+
+DECLARE_CYCLE_STAT(TEXT("Screen Monitor Paint"), STAT_FINScreenMonitorPaint, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Screen Monitor Draw Elements"), STAT_FINScreenMonitorDrawElements, STATGROUP_FicsItNetworks);
+DECLARE_CYCLE_STAT(TEXT("GPU T1 Set Text"), STAT_FINGPUT1SetText, STATGROUP_FicsItNetworks);
+DECLARE_CYCLE_STAT(TEXT("GPU T1 Fill"), STAT_FINGPUT1Fill, STATGROUP_FicsItNetworks);
+DECLARE_CYCLE_STAT(TEXT("GPU T1 Copy"), STAT_FINGPUT1Copy, STATGROUP_FicsItNetworks);
+DECLARE_CYCLE_STAT(TEXT("GPU T1 Set Buffer"), STAT_FINGPUT1SetBuffer, STATGROUP_FicsItNetworks);
+DECLARE_CYCLE_STAT(TEXT("GPU T1 Flush"), STAT_FINGPUT1Flush, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GPU T1 Merged Flushes"), STAT_FINGPUT1MergedFlushes, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GPU T1 Dropped Flushes"), STAT_FINGPUT1DroppedFlushes, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GPU T1 Input Batches"), STAT_FINGPUT1InputBatches, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GPU T1 Input Signals"), STAT_FINGPUT1InputSignals, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GPU T1 Merged Mouse Moves"), STAT_FINGPUT1MergedMouseMoves, STATGROUP_FicsItNetworks);
+
+void FFINGPUT1Buffer::SetSize(int32 InWidth, int32 InHeight, const FFINGPUT1BufferPixel& Clear) {
+	Width = FMath::Max(InWidth, 0);
+	Height = FMath::Max(InHeight, 0);
+	Pixels.Init(Clear, Width * Height);
+}
+
+void FFINGPUT1Buffer::SetChars(int32 X, int32 Y, const TCHAR* Chars, int32 Len, const FColor& Foreground, const FColor& Background) {
+	if (Y < 0 || Y >= Height) return;
+	if (X < 0) {
+		Chars -= X;
+		Len += X;
+		X = 0;
+	}
+	Len = FMath::Min(Len, Width - X);
+	FFINGPUT1BufferPixel* Pixel = Pixels.GetData() + Y * Width + X;
+	for (int32 i = 0; i < Len; ++i) {
+		Pixel[i] = FFINGPUT1BufferPixel(Chars[i], Foreground, Background);
+	}
+}
+
+FFINGPUT1BufferPixel FFINGPUT1Buffer::Get(int32 X, int32 Y) const {
+	if (X < 0 || Y < 0 || X >= Width || Y >= Height) return FFINGPUT1BufferPixel();
+	return Pixels[Y * Width + X];
+}
+
+TCHAR FFINGPUT1Buffer::GetFillChar(const FString& Str) {
+	TCHAR c = Str.Len() > 0 ? Str[0] : ' ';
+	if (Str.Len() <= 1 && (c < 32 || c == 127)) c = ' ';
+	return c;
+}
+
+void FFINGPUT1Buffer::SetText(int32 X, int32 Y, const FString& Text, const FColor& Foreground, const FColor& Background) {
+	const TCHAR* Chars = *Text;
+	const int32 Len = Text.Len();
+	int32 Start = 0;
+	for (int32 i = 0; i <= Len; ++i) {
+		if (i < Len && Chars[i] != '\n' && Chars[i] != '\r') continue;
+		SetChars(X, Y, Chars + Start, i - Start, Foreground, Background);
+		X += i - Start;
+		if (i < Len) {
+			if (Chars[i] == '\r') X = 0;
+			else ++Y;
+		}
+		Start = i + 1;
+	}
+}
+
+void FFINGPUT1Buffer::Fill(int32 X, int32 Y, int32 InWidth, int32 InHeight, const FFINGPUT1BufferPixel& Pixel) {
+	// computed in 64 bit, so large arguments can't overflow past the clipping
+	const int32 StartX = FMath::Max(X, 0);
+	const int32 EndX = static_cast<int32>(FMath::Min(static_cast<int64>(X) + InWidth, static_cast<int64>(Width)));
+	const int32 EndY = static_cast<int32>(FMath::Min(static_cast<int64>(Y) + InHeight, static_cast<int64>(Height)));
+	if (StartX >= EndX) return;
+	for (int32 Row = FMath::Max(Y, 0); Row < EndY; ++Row) {
+		FFINGPUT1BufferPixel* RowPixels = Pixels.GetData() + Row * Width;
+		for (int32 Column = StartX; Column < EndX; ++Column) RowPixels[Column] = Pixel;
+	}
+}
+
+void FFINGPUT1Buffer::Copy(int32 X, int32 Y, int32 InWidth, int32 InHeight, int32 DX, int32 DY) {
+	// clip the source rectangle so source and target are inside of the buffer,
+	// computed in 64 bit, so large arguments can't overflow past the clipping
+	if (DX == 0 && DY == 0) return;
+	const int64 StartX64 = FMath::Max3<int64>(X, 0, -static_cast<int64>(DX));
+	const int64 StartY64 = FMath::Max3<int64>(Y, 0, -static_cast<int64>(DY));
+	const int64 EndX64 = FMath::Min3<int64>(static_cast<int64>(X) + InWidth, Width, static_cast<int64>(Width) - DX);
+	const int64 EndY64 = FMath::Min3<int64>(static_cast<int64>(Y) + InHeight, Height, static_cast<int64>(Height) - DY);
+	if (StartX64 >= EndX64 || StartY64 >= EndY64) return;
+	const int32 StartX = static_cast<int32>(StartX64);
+	const int32 StartY = static_cast<int32>(StartY64);
+	const int32 EndX = static_cast<int32>(EndX64);
+	const int32 EndY = static_cast<int32>(EndY64);
+	const int32 RowLen = EndX - StartX;
+	// copy the rows in the opposite direction of the movement so overlapping rows get read before they get overwritten
+	for (int32 i = 0; i < EndY - StartY; ++i) {
+		const int32 Row = DY > 0 ? EndY - 1 - i : StartY + i;
+		FFINGPUT1BufferPixel* Source = Pixels.GetData() + Row * Width + StartX;
+		FMemory::Memmove(Source + DY * Width + DX, Source, RowLen * sizeof(FFINGPUT1BufferPixel));
+	}
+}
+
+int32 FFINGPUT1Buffer::CopyFrom(const FFINGPUT1Buffer& Other) {
+	const int32 CopyWidth = FMath::Min(Width, Other.Width);
+	const int32 CopyHeight = FMath::Min(Height, Other.Height);
+	int32 Changed = 0;
+	for (int32 Y = 0; Y < CopyHeight; ++Y) {
+		FFINGPUT1BufferPixel* Row = Pixels.GetData() + Y * Width;
+		const FFINGPUT1BufferPixel* OtherRow = Other.GetRow(Y);
+		for (int32 X = 0; X < CopyWidth; ++X) {
+			if (Row[X] == OtherRow[X]) continue;
+			Row[X] = OtherRow[X];
+			++Changed;
+		}
+	}
+	return Changed;
+}
 
 void SScreenMonitor::Construct(const FArguments& InArgs) {
-	Text = InArgs._Text;
-	Foreground = InArgs._Foreground;
-	Background = InArgs._Background;
+	Buffer = InArgs._Buffer;
 	Font = InArgs._Font;
 	ScreenSize = InArgs._ScreenSize;
 	OnMouseDownEvent = InArgs._OnMouseDown;
@@ -23,8 +132,8 @@ void SScreenMonitor::Construct(const FArguments& InArgs) {
 	SetCanTick(false);
 }
 
-TArray<FString> SScreenMonitor::GetText() const {
-	return Text.Get();
+FFINGPUT1Buffer SScreenMonitor::GetBuffer() const {
+	return Buffer.Get();
 }
 
 FVector2D SScreenMonitor::GetScreenSize() const {
@@ -36,10 +145,15 @@ void SScreenMonitor::SetScreenSize(FVector2D NewScreenSize) {
 }
 
 FVector2D SScreenMonitor::GetCharSize() const {
-	FSlateApplication& app = FSlateApplication::Get();
-	FSlateRenderer* renderer = app.GetRenderer();
-	TSharedRef<FSlateFontMeasure> measure = renderer->GetFontMeasureService();
-	return measure->Measure(L" ", Font.Get());
+	const FSlateFontInfo& FontInfo = Font.Get();
+	if (CachedCharSize.IsZero() || !(CachedCharSizeFont == FontInfo)) {
+		FSlateApplication& app = FSlateApplication::Get();
+		FSlateRenderer* renderer = app.GetRenderer();
+		TSharedRef<FSlateFontMeasure> measure = renderer->GetFontMeasureService();
+		CachedCharSize = measure->Measure(L" ", FontInfo);
+		CachedCharSizeFont = FontInfo;
+	}
+	return CachedCharSize;
 }
 
 FVector2D SScreenMonitor::LocalToCharPos(FVector2D Pos) const {
@@ -70,45 +184,75 @@ FVector2D SScreenMonitor::ComputeDesiredSize(float f) const {
 	return GetCharSize() * ScreenSize.Get();
 }
 
+/**
+ * Checks if the given character is a printable ASCII character,
+ * only these are known to have exactly the width of one cell in the monospace screen font.
+ */
+static bool IsSingleCellChar(TCHAR Char) {
+	return Char >= 0x20 && Char < 0x7F;
+}
+
 int32 SScreenMonitor::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const {
+	SCOPE_CYCLE_COUNTER(STAT_FINScreenMonitorPaint);
+	
 	FVector2D CharSize = GetCharSize();
 	FVector2D ScreenSizeV = ScreenSize.Get();
+	const FSlateFontInfo& FontInfo = Font.Get();
 	FSlateBrush boxBrush = FSlateBrush();
-	const TArray<FLinearColor>& ForegroundCache = this->Foreground.Get();
-	const TArray<FLinearColor>& BackgroundCache = this->Background.Get();
+	const FFINGPUT1Buffer& BufferV = Buffer.Get();
+	const int Width = FMath::Min(static_cast<int>(ScreenSizeV.X), BufferV.GetWidth());
+	int32 DrawElements = 0;
+	FString RunText;
 	
-	const TArray<FString>& TextGrid = Text.Get();
-	for (int Y = 0; Y < ScreenSizeV.Y && Y < TextGrid.Num(); ++Y) {
-		const FString Line = TextGrid[Y];
+	// adjacent cells with the same colors get merged into runs, so a row only needs one draw element per color change
+	for (int Y = 0; Y < ScreenSizeV.Y && Y < BufferV.GetHeight(); ++Y) {
+		const FFINGPUT1BufferPixel* Row = BufferV.GetRow(Y);
+
+		for (int X = 0; X < Width;) {
+			const FColor& BackgroundV = Row[X].Background;
+			int RunEnd = X + 1;
+			while (RunEnd < Width && Row[RunEnd].Background == BackgroundV) ++RunEnd;
+			if (BackgroundV.A > 0) {
+				FSlateDrawElement::MakeBox(
+					OutDrawElements,
+					LayerId,
+					AllottedGeometry.ToPaintGeometry(FVector2D(X, Y) * CharSize, FVector2D(CharSize.X * (RunEnd - X), CharSize.Y), 1),
+					&boxBrush,
+					ESlateDrawEffect::None,
+					BackgroundV.ReinterpretAsLinear());
+				++DrawElements;
+			}
+			X = RunEnd;
+		}
 		
-		for (int X = 0; X < ScreenSizeV.X && X < Line.Len(); ++X) {
-			FLinearColor ForegroundV = FLinearColor(1,1,1,1);
-			if (Y * ScreenSizeV.X + X < ForegroundCache.Num()) {
-				ForegroundV = ForegroundCache[Y * ScreenSizeV.X + X];
+		for (int X = 0; X < Width;) {
+			const FColor& ForegroundV = Row[X].Foreground;
+			if (ForegroundV.A < 1 || FChar::IsWhitespace(Row[X].Character)) {
+				++X;
+				continue;
 			}
-			FLinearColor BackgroundV = FLinearColor(0,0,0,0);
-			if (Y * ScreenSizeV.X + X < BackgroundCache.Num()) {
-				BackgroundV = BackgroundCache[Y * ScreenSizeV.X + X];
+			// only glyphs known to be exactly one cell wide get merged, anything else gets drawn at its own cell
+			int RunEnd = X + 1;
+			if (IsSingleCellChar(Row[X].Character)) {
+				while (RunEnd < Width && Row[RunEnd].Foreground == ForegroundV && IsSingleCellChar(Row[RunEnd].Character)) ++RunEnd;
+				while (RunEnd > X + 1 && Row[RunEnd-1].Character == ' ') --RunEnd;
 			}
-
+			RunText.Reset(RunEnd - X);
+			for (int i = X; i < RunEnd; ++i) RunText.AppendChar(Row[i].Character);
 			FSlateDrawElement::MakeText(
-                OutDrawElements,
-                LayerId+1,
-                AllottedGeometry.ToOffsetPaintGeometry(FVector2D(X,Y) * CharSize),
-                Line.Mid(X,1),
-                Font.Get(),
-                ESlateDrawEffect::None,
-                ForegroundV
-            );
-			FSlateDrawElement::MakeBox(
 				OutDrawElements,
-				LayerId,
-				AllottedGeometry.ToPaintGeometry(FVector2D(X, Y) * CharSize, (CharSize*1), 1),
-				&boxBrush,
+				LayerId+1,
+				AllottedGeometry.ToOffsetPaintGeometry(FVector2D(X, Y) * CharSize),
+				RunText,
+				FontInfo,
 				ESlateDrawEffect::None,
-				BackgroundV);
+				ForegroundV.ReinterpretAsLinear()
+			);
+			++DrawElements;
+			X = RunEnd;
 		}
 	}
+	INC_DWORD_STAT_BY(STAT_FINScreenMonitorDrawElements, DrawElements);
 	return LayerId;
 }
 
@@ -169,11 +313,94 @@ AFINComputerGPUT1::AFINComputerGPUT1() {
 
 void AFINComputerGPUT1::Tick(float DeltaSeconds) {
 	Super::Tick(DeltaSeconds);
-	if (HasAuthority() && bFlushed) {
-		bFlushed = false;
-		ForceNetUpdate();
-		Flush();
+	if (PendingInput.Num() > 0) {
+		AFGPlayerController* Controller = Cast<AFGPlayerController>(GetWorld()->GetFirstPlayerController());
+		UFINComputerRCO* RCO = Controller ? Cast<UFINComputerRCO>(Controller->GetRemoteCallObjectOfClass(UFINComputerRCO::StaticClass())) : nullptr;
+		if (RCO) {
+			// send oversized batches over multiple ticks, so the server doesn't drop any of them
+			if (PendingInput.Num() > MaxInputBatchSize) {
+				RCO->GPUInputEvents(this, TArray<FFINGPUT1InputEvent>(PendingInput.GetData(), MaxInputBatchSize));
+				PendingInput.RemoveAt(0, MaxInputBatchSize);
+			} else {
+				RCO->GPUInputEvents(this, PendingInput);
+				PendingInput.Empty();
+			}
+		} else {
+			PendingInput.Empty();
+		}
+	}
+	if (HasAuthority()) {
+		MouseMoveBudget = FMath::Min(MouseMoveBudget + DeltaSeconds * MouseMoveRateLimit, 1.0f);
+		if (bHasPendingMouseMove && MouseMoveBudget >= 1.0f) {
+			MouseMoveBudget -= 1.0f;
+			bHasPendingMouseMove = false;
+			EmitInputEvent(PendingMouseMove);
+		}
+	}
+	if (HasAuthority()) {
+		const float Now = GetWorld()->GetTimeSeconds();
+		bool bDoFlush = false;
+		{
+			// flush state and interval get written by runtime functions off the game thread
+			FScopeLock Lock(&DrawingMutex);
+			if (bFlushed && (LastFlushTime < 0.0f || Now - LastFlushTime >= FlushInterval)) {
+				FrontBuffer = PendingBuffer;
+				bFlushed = false;
+				bDoFlush = true;
+			}
+		}
+		if (bDoFlush) {
+			LastFlushTime = Now;
+			ForceNetUpdate();
+			Flush();
+		}
+	}
+}
+
+float AFINComputerGPUT1::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) {
+	float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+	AActor* ScreenActor = Cast<AActor>(ScreenPtr);
+	if (!ScreenActor && Cast<UActorComponent>(ScreenPtr)) ScreenActor = Cast<UActorComponent>(ScreenPtr)->GetOwner();
+	if (ScreenActor && FlushRelevancyDistance > 0.0f) {
+		const float DistSq = FVector::DistSquared(ViewPos, ScreenActor->GetActorLocation());
+		const float RelevancyDistSq = FlushRelevancyDistance * FlushRelevancyDistance;
+		if (DistSq > RelevancyDistSq) Priority *= RelevancyDistSq / DistSq;
 	}
+	return Priority;
+}
+
+void AFINComputerGPUT1::PreSaveGame_Implementation(int32 gameVersion, int32 engineVersion) {
+	Super::PreSaveGame_Implementation(gameVersion, engineVersion);
+
+	FScopeLock Lock(&DrawingMutex);
+	if (bFlushed) FrontBuffer = PendingBuffer;
+}
+
+/**
+ * Converts a character grid of saves before the packed buffer to the given buffer and empties the old grid.
+ */
+static void ConvertLegacyTextGrid(FFINGPUT1Buffer& Buffer, const FVector2D& Size, TArray<FString>& TextGrid, TArray<FLinearColor>& Foreground, TArray<FLinearColor>& Background) {
+	const FFINGPUT1BufferPixel Default;
+	Buffer.SetSize(Size.X, Size.Y, Default);
+	for (int Y = 0; Y < Size.Y && Y < TextGrid.Num(); ++Y) {
+		const FString& Line = TextGrid[Y];
+		for (int X = 0; X < Size.X && X < Line.Len(); ++X) {
+			const int Index = Y * Size.X + X;
+			const FColor ForegroundV = Index < Foreground.Num() ? Foreground[Index].ToFColor(false) : Default.Foreground;
+			const FColor BackgroundV = Index < Background.Num() ? Background[Index].ToFColor(false) : Default.Background;
+			Buffer.SetChars(X, Y, &Line[X], 1, ForegroundV, BackgroundV);
+		}
+	}
+	TextGrid.Empty();
+	Foreground.Empty();
+	Background.Empty();
+}
+
+void AFINComputerGPUT1::PostLoadGame_Implementation(int32 gameVersion, int32 engineVersion) {
+	Super::PostLoadGame_Implementation(gameVersion, engineVersion);
+
+	if (TextGrid.Num() > 0) ConvertLegacyTextGrid(FrontBuffer, ScreenSize, TextGrid, Foreground, Background);
+	if (TextGridBuffer.Num() > 0) ConvertLegacyTextGrid(BackBuffer, ScreenSize, TextGridBuffer, ForegroundBuffer, BackgroundBuffer);
 }
 
 void AFINComputerGPUT1::BindScreen(const FFINNetworkTrace& screen) {
@@ -183,49 +410,40 @@ void AFINComputerGPUT1::BindScreen(const FFINNetworkTrace& screen) {
 void AFINComputerGPUT1::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	DOREPLIFETIME(AFINComputerGPUT1, TextGrid);
-	DOREPLIFETIME(AFINComputerGPUT1, Foreground);
-	DOREPLIFETIME(AFINComputerGPUT1, Background);
+	DOREPLIFETIME(AFINComputerGPUT1, FrontBuffer);
 	DOREPLIFETIME(AFINComputerGPUT1, ScreenSize);
 }
 
 TSharedPtr<SWidget> AFINComputerGPUT1::CreateWidget() {
 	boxBrush = LoadObject<USlateBrushAsset>(NULL, TEXT("SlateBrushAsset'/Game/FicsItNetworks/Computer/UI/ComputerCaseBorder.ComputerCaseBorder'"))->Brush;
-	UFINComputerRCO* RCO = Cast<UFINComputerRCO>(Cast<AFGPlayerController>(GetWorld()->GetFirstPlayerController())->GetRemoteCallObjectOfClass(UFINComputerRCO::StaticClass()));
 	return SAssignNew(CachedInvalidation, SInvalidationPanel)
 	.Content()[
 		SNew(SScreenMonitor)
 		.ScreenSize_Lambda([this]() {
 			return ScreenSize;
 		})
-		.Text_Lambda([this]() {
-            return TextGrid;
-		})
-		.Foreground_Lambda([this]() {
-			return Foreground;
-		})
-		.Background_Lambda([this]() {
-			return Background;
+		.Buffer_Lambda([this]() {
+			return FrontBuffer;
 		})
 		.Font(FSlateFontInfo(LoadObject<UObject>(NULL, TEXT("Font'/Game/FicsItNetworks/GuiHelpers/Inconsolata_Font.Inconsolata_Font'")), 12, "InConsolata"))
-		.OnMouseDown_Lambda([this, RCO](int x, int y, int btn) {
-			RCO->GPUMouseEvent(this, 0, x, y, btn);
+		.OnMouseDown_Lambda([this](int x, int y, int btn) {
+			QueueInputEvent(FFINGPUT1InputEvent(0, x, y, btn));
 			return FReply::Handled();
 		})
-		.OnMouseUp_Lambda([this, RCO](int x, int y, int btn) {
-			RCO->GPUMouseEvent(this, 1, x, y, btn);
+		.OnMouseUp_Lambda([this](int x, int y, int btn) {
+			QueueInputEvent(FFINGPUT1InputEvent(1, x, y, btn));
             return FReply::Handled();
         })
-        .OnMouseMove_Lambda([this, RCO](int x, int y, int btn) {
-			RCO->GPUMouseEvent(this, 2, x, y, btn);
+        .OnMouseMove_Lambda([this](int x, int y, int btn) {
+			QueueInputEvent(FFINGPUT1InputEvent(2, x, y, btn));
             return FReply::Handled();
         })
-		.OnKeyDown_Lambda([this, RCO](uint32 c, uint32 key, int btn) {
-			RCO->GPUKeyEvent(this, 0,  c, key, btn);
+		.OnKeyDown_Lambda([this](uint32 c, uint32 key, int btn) {
+			QueueInputEvent(FFINGPUT1InputEvent(3, c, key, btn));
 			return FReply::Handled();
 		})
-		.OnKeyUp_Lambda([this, RCO](uint32 c, uint32 key, int btn) {
-			RCO->GPUKeyEvent(this, 1,  c, key, btn);
+		.OnKeyUp_Lambda([this](uint32 c, uint32 key, int btn) {
+			QueueInputEvent(FFINGPUT1InputEvent(4, c, key, btn));
 			return FReply::Handled();
         })
     ];
@@ -236,21 +454,9 @@ void AFINComputerGPUT1::SetScreenSize(FVector2D size) {
 	FVector2D oldScreenSize = ScreenSize;
 	ScreenSize = size;
 
-	TextGrid.Empty();
-	Foreground.Empty();
-	Background.Empty();
-
-	for (int y = 0; y < size.Y; ++y) {
-		TextGrid.Add(FString::ChrN(size.X, ' '));
-		for (int x = 0; x < size.X; ++x) {
-			Foreground.Add(CurrentForeground);
-			Background.Add(CurrentBackground);
-		}
-	}
-
-	TextGridBuffer = TextGrid;
-	ForegroundBuffer = Foreground;
-	BackgroundBuffer = Background;
+	FrontBuffer.SetSize(size.X, size.Y, FFINGPUT1BufferPixel(' ', CurrentForeground.ToFColor(false), CurrentBackground.ToFColor(false)));
+	BackBuffer = FrontBuffer;
+	bFlushed = false;
 
 	if (PrimaryActorTick.bCanEverTick) netSig_ScreenSizeChanged(oldScreenSize.X, oldScreenSize.Y);
 
@@ -264,6 +470,66 @@ void AFINComputerGPUT1::Flush_Implementation() {
 	}
 }
 
+void AFINComputerGPUT1::QueueInputEvent(const FFINGPUT1InputEvent& Event) {
+	if (Event.Type == 2 && PendingInput.Num() > 0 && PendingInput.Last().Type == 2) {
+		PendingInput.Last() = Event;
+	} else {
+		PendingInput.Add(Event);
+	}
+}
+
+void AFINComputerGPUT1::HandleInputEvents(const TArray<FFINGPUT1InputEvent>& Events) {
+	INC_DWORD_STAT(STAT_FINGPUT1InputBatches);
+	const int32 Count = FMath::Min(Events.Num(), MaxInputBatchSize);
+	for (int32 i = 0; i < Count; ++i) {
+		const FFINGPUT1InputEvent& Event = Events[i];
+		if (Event.Type == 2) {
+			if (!bHasPendingMouseMove && MouseMoveBudget >= 1.0f) {
+				MouseMoveBudget -= 1.0f;
+				EmitInputEvent(Event);
+			} else {
+				if (bHasPendingMouseMove) {
+					++MergedMouseMoves;
+					INC_DWORD_STAT(STAT_FINGPUT1MergedMouseMoves);
+				}
+				PendingMouseMove = Event;
+				bHasPendingMouseMove = true;
+			}
+		} else {
+			// the cursor has to be at its latest position before any other event happens
+			if (bHasPendingMouseMove) {
+				bHasPendingMouseMove = false;
+				EmitInputEvent(PendingMouseMove);
+			}
+			EmitInputEvent(Event);
+		}
+	}
+}
+
+void AFINComputerGPUT1::EmitInputEvent(const FFINGPUT1InputEvent& Event) {
+	switch (Event.Type) {
+	case 0:
+		netSig_OnMouseDown(Event.X, Event.Y, Event.Btn);
+		break;
+	case 1:
+		netSig_OnMouseUp(Event.X, Event.Y, Event.Btn);
+		break;
+	case 2:
+		netSig_OnMouseMove(Event.X, Event.Y, Event.Btn);
+		break;
+	case 3:
+		netSig_OnKeyDown(Event.X, Event.Y, Event.Btn);
+		break;
+	case 4:
+		netSig_OnKeyUp(Event.X, Event.Y, Event.Btn);
+		break;
+	default:
+		return;
+	}
+	++SignaledInputEvents;
+	INC_DWORD_STAT(STAT_FINGPUT1InputSignals);
+}
+
 void AFINComputerGPUT1::netSig_OnMouseDown_Implementation(int x, int y, int btn) {}
 void AFINComputerGPUT1::netSig_OnMouseUp_Implementation(int x, int y, int btn) {}
 void AFINComputerGPUT1::netSig_OnMouseMove_Implementation(int x, int y, int btn) {}
@@ -280,58 +546,32 @@ UObject* AFINComputerGPUT1::netFunc_getScreen() {
 }
 
 void AFINComputerGPUT1::netFunc_setText(int x, int y, const FString& str) {
+	SCOPE_CYCLE_COUNTER(STAT_FINGPUT1SetText);
 	FScopeLock Lock(&DrawingMutex);
-	FString toSet = str;
-	while (toSet.Len() > 0) {
-		FString Line;
-		bool newLine = toSet.Split("\n", &Line, &toSet);
-		if (!newLine) {
-			Line = toSet;
-			toSet = "";
-		}
-		while (Line.Len() > 0) {
-			FString inLine;
-			bool returned = Line.Split("\r", &inLine, &Line);
-			if (!returned) {
-				inLine = Line;
-				Line = "";
-			}
-			int oldX = x + inLine.Len();
-			if (y >= 0 && x < ScreenSize.X && y < ScreenSize.Y) {
-				if (x < 0) {
-					if (inLine.Len() < FMath::Abs(x)) {
-						x = -1;
-					} else {
-						inLine.RemoveAt(0, FMath::Abs(x));
-						x = 0;
-					}
-				}
-				if (x >= 0) {
-					FString& text = TextGridBuffer[y];
-					int replace = FMath::Clamp(inLine.Len(), 0, static_cast<int>(ScreenSize.X)-x-1);
-					text.RemoveAt(x, replace);
-					text.InsertAt(x, inLine.Left(replace));
-					for (int dx = 0; dx < replace; ++dx) {
-						ForegroundBuffer[y * ScreenSize.X + x + dx] = CurrentForeground;
-						BackgroundBuffer[y * ScreenSize.X + x + dx] = CurrentBackground;
-					}
-				}
-			}
-			x = oldX;
-			if (returned) x = 0;
-		}
-		if (newLine) ++y;
-	}
+	BackBuffer.SetText(x, y, str, CurrentForeground.ToFColor(false), CurrentBackground.ToFColor(false));
 }
 
 void AFINComputerGPUT1::netFunc_fill(int x, int y, int dx, int dy, const FString& str) {
-	FString c = str;
-	if (FRegexMatcher(FRegexPattern("^[[:cntrl:]]?$"), c).FindNext()) c = " ";
-	if (dx < 0) dx = 0;
-	if (dy < 0) dy = 0;
-	for (int ny = y; ny < y+dy; ++ny) {
-		netFunc_setText(x, ny, FString::ChrN(dx, c[0]));
-	}
+	SCOPE_CYCLE_COUNTER(STAT_FINGPUT1Fill);
+	FScopeLock Lock(&DrawingMutex);
+	BackBuffer.Fill(x, y, dx, dy, FFINGPUT1BufferPixel(FFINGPUT1Buffer::GetFillChar(str), CurrentForeground.ToFColor(false), CurrentBackground.ToFColor(false)));
+}
+
+void AFINComputerGPUT1::netFunc_copy(int x, int y, int w, int h, int dx, int dy) {
+	SCOPE_CYCLE_COUNTER(STAT_FINGPUT1Copy);
+	FScopeLock Lock(&DrawingMutex);
+	BackBuffer.Copy(x, y, w, h, dx, dy);
+}
+
+FFINGPUT1Buffer AFINComputerGPUT1::netFunc_getBuffer() {
+	FScopeLock Lock(&DrawingMutex);
+	return BackBuffer;
+}
+
+int AFINComputerGPUT1::netFunc_setBuffer(const FFINGPUT1Buffer& Buffer) {
+	SCOPE_CYCLE_COUNTER(STAT_FINGPUT1SetBuffer);
+	FScopeLock Lock(&DrawingMutex);
+	return BackBuffer.CopyFrom(Buffer);
 }
 
 void AFINComputerGPUT1::netFunc_getSize(int& w, int& h) {
@@ -355,9 +595,37 @@ void AFINComputerGPUT1::netFunc_setBackground(float r, float g, float b, float a
 }
 
 void AFINComputerGPUT1::netFunc_flush() {
+	SCOPE_CYCLE_COUNTER(STAT_FINGPUT1Flush);
 	FScopeLock Lock(&DrawingMutex);
-	TextGrid = TextGridBuffer;
-	Foreground = ForegroundBuffer;
-	Background = BackgroundBuffer;
+	if (bFlushed) {
+		++MergedFlushes;
+		INC_DWORD_STAT(STAT_FINGPUT1MergedFlushes);
+	} else if (FrontBuffer == BackBuffer) {
+		++DroppedFlushes;
+		INC_DWORD_STAT(STAT_FINGPUT1DroppedFlushes);
+		return;
+	}
+	PendingBuffer = BackBuffer;
 	bFlushed = true;
 }
+
+void AFINComputerGPUT1::netFunc_setFlushInterval(float interval) {
+	FScopeLock Lock(&DrawingMutex);
+	FlushInterval = FMath::Clamp(interval, 0.0f, 10.0f);
+}
+
+float AFINComputerGPUT1::netFunc_getFlushInterval() {
+	FScopeLock Lock(&DrawingMutex);
+	return FlushInterval;
+}
+
+void AFINComputerGPUT1::netFunc_getFlushStats(int& merged, int& dropped) {
+	FScopeLock Lock(&DrawingMutex);
+	merged = MergedFlushes;
+	dropped = DroppedFlushes;
+}
+
+void AFINComputerGPUT1::netFunc_getInputStats(int& signaled, int& merged) {
+	signaled = SignaledInputEvents;
+	merged = MergedMouseMoves;
+}
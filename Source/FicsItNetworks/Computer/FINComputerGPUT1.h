@@ -5,21 +5,186 @@
 
 #include "FINComputerGPUT1.generated.h"
 
+/**
+ * A single character cell of the T1 GPU character grid.
+ * The colors are stored with 8 bit per channel so the whole grid is one small contiguous array.
+ */
+USTRUCT()
+struct FICSITNETWORKS_API FFINGPUT1BufferPixel {
+	GENERATED_BODY()
+
+	UPROPERTY(SaveGame)
+	uint16 Character = ' ';
+
+	UPROPERTY(SaveGame)
+	FColor Foreground = FColor(255, 255, 255, 255);
+
+	UPROPERTY(SaveGame)
+	FColor Background = FColor(0, 0, 0, 0);
+
+	FFINGPUT1BufferPixel() = default;
+	FFINGPUT1BufferPixel(TCHAR Character, const FColor& Foreground, const FColor& Background) : Character(Character), Foreground(Foreground), Background(Background) {}
+
+	bool operator==(const FFINGPUT1BufferPixel& Other) const {
+		return Character == Other.Character && Foreground == Other.Foreground && Background == Other.Background;
+	}
+};
+
+/**
+ * The character grid of the T1 GPU stored row by row in one contiguous array.
+ */
+USTRUCT()
+struct FICSITNETWORKS_API FFINGPUT1Buffer {
+	GENERATED_BODY()
+private:
+	UPROPERTY(SaveGame)
+	int32 Width = 0;
+
+	UPROPERTY(SaveGame)
+	int32 Height = 0;
+
+	UPROPERTY(SaveGame)
+	TArray<FFINGPUT1BufferPixel> Pixels;
+
+public:
+	/**
+	 * Resizes the buffer to the given size and clears every cell with the given pixel.
+	 */
+	void SetSize(int32 InWidth, int32 InHeight, const FFINGPUT1BufferPixel& Clear);
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+	/**
+	 * Returns the cells of the given row. Has GetWidth() entries.
+	 */
+	FORCEINLINE const FFINGPUT1BufferPixel* GetRow(int32 Y) const {
+		return Pixels.GetData() + Y * Width;
+	}
+
+	/**
+	 * Returns the cell at the given position, or a default cell if the position is outside of the buffer.
+	 */
+	FFINGPUT1BufferPixel Get(int32 X, int32 Y) const;
+
+	/**
+	 * Returns the character a fill with the given string should use.
+	 * That is the first character of the string or a space if the string is empty or a single control character.
+	 */
+	static TCHAR GetFillChar(const FString& Str);
+
+	/**
+	 * Sets the characters of the given row starting at the given column to the given characters and colors.
+	 * Everything outside of the buffer gets clipped.
+	 *
+	 * @param[in]	X			the column of the first character, can be negative
+	 * @param[in]	Y			the row of the characters
+	 * @param[in]	Chars		the characters you want to set
+	 * @param[in]	Len			the amount of characters
+	 * @param[in]	Foreground	the foreground color of the set cells
+	 * @param[in]	Background	the background color of the set cells
+	 */
+	void SetChars(int32 X, int32 Y, const TCHAR* Chars, int32 Len, const FColor& Foreground, const FColor& Background);
+
+	/**
+	 * Draws the given text at the given position.
+	 * Every segment between line breaks gets written as one span, "\r" returns to the first column
+	 * and "\n" advances to the next row.
+	 *
+	 * @param[in]	X			the column of the first character, can be negative
+	 * @param[in]	Y			the row of the first character, can be negative
+	 * @param[in]	Text		the text you want to draw
+	 * @param[in]	Foreground	the foreground color of the set cells
+	 * @param[in]	Background	the background color of the set cells
+	 */
+	void SetText(int32 X, int32 Y, const FString& Text, const FColor& Foreground, const FColor& Background);
+
+	/**
+	 * Sets every cell in the given rectangle to the given pixel.
+	 * Everything outside of the buffer gets clipped.
+	 *
+	 * @param[in]	X		the column of the upper left corner of the rectangle
+	 * @param[in]	Y		the row of the upper left corner of the rectangle
+	 * @param[in]	InWidth		the width of the rectangle
+	 * @param[in]	InHeight	the height of the rectangle
+	 * @param[in]	Pixel	the character and colors the cells should get
+	 */
+	void Fill(int32 X, int32 Y, int32 InWidth, int32 InHeight, const FFINGPUT1BufferPixel& Pixel);
+
+	/**
+	 * Copies the cells of the given rectangle by the given offset, overlapping source and target are allowed.
+	 * Cells which would get copied from or to outside of the buffer get clipped.
+	 * The cells in the source rectangle which don't get overwritten stay as they are.
+	 *
+	 * @param[in]	X		the column of the upper left corner of the source rectangle
+	 * @param[in]	Y		the row of the upper left corner of the source rectangle
+	 * @param[in]	InWidth		the width of the source rectangle
+	 * @param[in]	InHeight	the height of the source rectangle
+	 * @param[in]	DX		the amount of columns the cells get moved by
+	 * @param[in]	DY		the amount of rows the cells get moved by
+	 */
+	void Copy(int32 X, int32 Y, int32 InWidth, int32 InHeight, int32 DX, int32 DY);
+
+	/**
+	 * Copies the cells of the given buffer into this buffer, only the area both buffers cover gets copied.
+	 * Only cells which differ get written.
+	 *
+	 * @param[in]	Other	the buffer you want to copy the cells from
+	 * @return	the amount of cells which changed
+	 */
+	int32 CopyFrom(const FFINGPUT1Buffer& Other);
+
+	bool operator==(const FFINGPUT1Buffer& Other) const {
+		return Width == Other.Width && Height == Other.Height && Pixels == Other.Pixels;
+	}
+};
+
+/**
+ * A single mouse or keyboard event of a screen monitor.
+ * Gets sent in batches from the client to the server.
+ */
+USTRUCT()
+struct FFINGPUT1InputEvent {
+	GENERATED_BODY()
+
+	/**
+	 * 0 = mouse down, 1 = mouse up, 2 = mouse move, 3 = key down, 4 = key up
+	 */
+	UPROPERTY()
+	uint8 Type = 0;
+
+	/**
+	 * The x position of mouse events, the character of key events
+	 */
+	UPROPERTY()
+	int64 X = 0;
+
+	/**
+	 * The y position of mouse events, the key code of key events
+	 */
+	UPROPERTY()
+	int64 Y = 0;
+
+	UPROPERTY()
+	int32 Btn = 0;
+
+	FFINGPUT1InputEvent() = default;
+	FFINGPUT1InputEvent(uint8 Type, int64 X, int64 Y, int32 Btn) : Type(Type), X(X), Y(Y), Btn(Btn) {}
+};
+
 DECLARE_DELEGATE_RetVal_ThreeParams(FReply, FScreenCursorEventHandler, int, int, int);
 DECLARE_DELEGATE_RetVal_ThreeParams(FReply, FScreenKeyEventHandler, uint32, uint32, int);
 
 class FICSITNETWORKS_API SScreenMonitor : public SLeafWidget {
-	SLATE_BEGIN_ARGS(SScreenMonitor) : _Text(),
+	SLATE_BEGIN_ARGS(SScreenMonitor) : _Buffer(),
 		_Font(),
 		_ScreenSize()
 		{
 			_Clipping = EWidgetClipping::OnDemand;
 		}
-		SLATE_ATTRIBUTE(TArray<FString>, Text)
+		SLATE_ATTRIBUTE(FFINGPUT1Buffer, Buffer)
 		SLATE_ATTRIBUTE(FSlateFontInfo, Font)
 		SLATE_ATTRIBUTE(FVector2D, ScreenSize)
-		SLATE_ATTRIBUTE(TArray<FLinearColor>, Foreground)
-		SLATE_ATTRIBUTE(TArray<FLinearColor>, Background)
 
 		SLATE_EVENT(FScreenCursorEventHandler, OnMouseDown)
 		SLATE_EVENT(FScreenCursorEventHandler, OnMouseUp)
@@ -32,11 +197,11 @@ public:
     void Construct( const FArguments& InArgs );
 
 	/**
-	 * Returns the currently displayed text grid.
+	 * Returns the currently displayed character grid.
 	 *
-	 * @return	the currently displayed text grid
+	 * @return	the currently displayed character grid
 	 */
-	TArray<FString> GetText() const;
+	FFINGPUT1Buffer GetBuffer() const;
 
 	/**
 	 * Allows you to get information about the character screen size.
@@ -53,7 +218,8 @@ public:
 	void SetScreenSize(FVector2D ScreenSize);
 
 	/**
-	 * This function returns the size of a single displayed character slot in the widgets local space
+	 * This function returns the size of a single displayed character slot in the widgets local space.
+	 * The size gets cached and only measured again if the font changes.
 	 *
 	 * @return	the character slot size in local space
 	 */
@@ -98,9 +264,7 @@ public:
 	static int InputToInt(const FInputEvent& InputEvent);
 	
 private:
-    TAttribute<TArray<FString>> Text;
-	TAttribute<TArray<FLinearColor>> Foreground;
-	TAttribute<TArray<FLinearColor>> Background;
+    TAttribute<FFINGPUT1Buffer> Buffer;
 	TAttribute<FSlateFontInfo> Font;
 	TAttribute<FVector2D> ScreenSize;
 	FScreenCursorEventHandler OnMouseDownEvent;
@@ -111,6 +275,9 @@ private:
 
 	int lastMoveX = -1;
 	int lastMoveY = -1;
+
+	mutable FSlateFontInfo CachedCharSizeFont;
+	mutable FVector2D CachedCharSize = FVector2D::ZeroVector;
     
 public:
 	SScreenMonitor();
@@ -133,7 +300,7 @@ class AFINComputerGPUT1 : public AFINComputerGPU {
 	GENERATED_BODY()
 private:
 	UPROPERTY(SaveGame, Replicated)
-	TArray<FString> TextGrid;
+	FFINGPUT1Buffer FrontBuffer;
 
 	UPROPERTY(SaveGame, Replicated)
 	FVector2D ScreenSize;
@@ -144,10 +311,40 @@ private:
 	UPROPERTY(SaveGame)
 	FLinearColor CurrentBackground = FLinearColor(0,0,0,0);
 
-	UPROPERTY(SaveGame, Replicated)
+	UPROPERTY(SaveGame)
+	FFINGPUT1Buffer BackBuffer;
+
+	/**
+	 * The buffer of the last flush which didn't get replicated yet.
+	 */
+	FFINGPUT1Buffer PendingBuffer;
+
+	/**
+	 * The minimum time in seconds between two replicated flushes.
+	 * Flushes within that time get merged into one.
+	 */
+	UPROPERTY(SaveGame)
+	float FlushInterval = 0.05f;
+
+	/**
+	 * The distance from the screen after which the replication priority of flushes gets reduced.
+	 * Clients farther away get updates less often if the bandwidth is limited.
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	float FlushRelevancyDistance = 5000.0f;
+
+	float LastFlushTime = -1.0f;
+	int32 MergedFlushes = 0;
+	int32 DroppedFlushes = 0;
+
+	// Character grids of saves before the packed buffers, only used to convert those saves
+	UPROPERTY(SaveGame)
+	TArray<FString> TextGrid;
+
+	UPROPERTY(SaveGame)
 	TArray<FLinearColor> Foreground;
 
-	UPROPERTY(SaveGame, Replicated)
+	UPROPERTY(SaveGame)
 	TArray<FLinearColor> Background;
 
 	UPROPERTY(SaveGame)
@@ -165,14 +362,36 @@ private:
 	TSharedPtr<SInvalidationPanel> CachedInvalidation;
 	bool bFlushed = false;
 	FCriticalSection DrawingMutex;
+
+	// Input events of the local client which didn't get sent to the server yet
+	TArray<FFINGPUT1InputEvent> PendingInput;
+
+	/**
+	 * The max amount of mouse move signals emitted per second.
+	 * Mouse moves exceeding the limit get merged, so only the latest position gets signaled.
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	float MouseMoveRateLimit = 30.0f;
+	
+	float MouseMoveBudget = 1.0f;
+	bool bHasPendingMouseMove = false;
+	FFINGPUT1InputEvent PendingMouseMove;
+	int32 SignaledInputEvents = 0;
+	int32 MergedMouseMoves = 0;
 	
 public:
 	AFINComputerGPUT1();
 
 	// Begin AActor
 	virtual void Tick(float DeltaSeconds) override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
 	// End AActor
 
+	// Begin IFGSaveInterface
+	virtual void PreSaveGame_Implementation(int32 gameVersion, int32 engineVersion) override;
+	virtual void PostLoadGame_Implementation(int32 gameVersion, int32 engineVersion) override;
+	// End IFGSaveInterface
+
 	// Begin IFINGraphicsPorcessingUnit
 	virtual void BindScreen(const FFINNetworkTrace& Screen) override;
 	// End IFINGraphicsProcessingUnit
@@ -186,6 +405,40 @@ public:
 	*/
 	void SetScreenSize(FVector2D size);
 
+	/**
+	 * The maximum count of input events sent to the server in one batch.
+	 * The server ignores any events of a batch exceeding this count.
+	 */
+	static constexpr int32 MaxInputBatchSize = 1024;
+
+	/**
+	 * Queues the given input event of the local client, so it gets sent to the server with the next batch.
+	 * A mouse move directly following another mouse move replaces it.
+	 *
+	 * Client Only
+	 *
+	 * @param[in]	Event	the input event of the screen monitor
+	 */
+	void QueueInputEvent(const FFINGPUT1InputEvent& Event);
+
+	/**
+	 * Emits the signals of the given input events received from a client.
+	 * Mouse moves are rate limited, moves exceeding the limit get merged into the latest position.
+	 * Only the first MaxInputBatchSize events get handled, the rest gets dropped.
+	 *
+	 * Server Only
+	 *
+	 * @param[in]	Events	the input events in the order they occurred
+	 */
+	void HandleInputEvents(const TArray<FFINGPUT1InputEvent>& Events);
+
+	/**
+	 * Emits the signal for the given input event.
+	 *
+	 * Server Only
+	 */
+	void EmitInputEvent(const FFINGPUT1InputEvent& Event);
+
 	/**
 	 * Validates the screen widget on all clients and server
 	 */
@@ -379,6 +632,63 @@ public:
 		Runtime = 2;
 	}
 
+	UFUNCTION()
+	void netFunc_copy(int x, int y, int w, int h, int dx, int dy);
+	UFUNCTION()
+    void netFuncMeta_copy(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "copy";
+		DisplayName = FText::FromString("Copy");
+		Description = FText::FromString("Copies the characters and colors of the given rectangle of the hidden screen buffer by the given offset. Allows to scroll parts of the screen without drawing them again.");
+		ParameterInternalNames.Add("x");
+		ParameterDisplayNames.Add(FText::FromString("X"));
+		ParameterDescriptions.Add(FText::FromString("The x coordinate of the rectangle you want to copy. (upper-left corner)"));
+		ParameterInternalNames.Add("y");
+		ParameterDisplayNames.Add(FText::FromString("Y"));
+		ParameterDescriptions.Add(FText::FromString("The y coordinate of the rectangle you want to copy. (upper-left corner)"));
+		ParameterInternalNames.Add("w");
+		ParameterDisplayNames.Add(FText::FromString("Width"));
+		ParameterDescriptions.Add(FText::FromString("The width of the rectangle."));
+		ParameterInternalNames.Add("h");
+		ParameterDisplayNames.Add(FText::FromString("Height"));
+		ParameterDescriptions.Add(FText::FromString("The height of the rectangle."));
+		ParameterInternalNames.Add("dx");
+		ParameterDisplayNames.Add(FText::FromString("DX"));
+		ParameterDescriptions.Add(FText::FromString("The amount of columns the rectangle gets moved by. Negative values move to the left."));
+		ParameterInternalNames.Add("dy");
+		ParameterDisplayNames.Add(FText::FromString("DY"));
+		ParameterDescriptions.Add(FText::FromString("The amount of rows the rectangle gets moved by. Negative values move up."));
+		Runtime = 2;
+	}
+
+	UFUNCTION()
+	FFINGPUT1Buffer netFunc_getBuffer();
+	UFUNCTION()
+    void netFuncMeta_getBuffer(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "getBuffer";
+		DisplayName = FText::FromString("Get Buffer");
+		Description = FText::FromString("Returns a copy of the hidden screen buffer. The copy can get changed locally without any calls to the GPU and then get uploaded with setBuffer.");
+		ParameterInternalNames.Add("buffer");
+		ParameterDisplayNames.Add(FText::FromString("Buffer"));
+		ParameterDescriptions.Add(FText::FromString("The copy of the hidden screen buffer."));
+		Runtime = 2;
+	}
+
+	UFUNCTION()
+	int netFunc_setBuffer(const FFINGPUT1Buffer& Buffer);
+	UFUNCTION()
+    void netFuncMeta_setBuffer(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "setBuffer";
+		DisplayName = FText::FromString("Set Buffer");
+		Description = FText::FromString("Uploads the given buffer to the hidden screen buffer in one call. Only the cells which differ from the hidden screen buffer get written, cells outside of the screen get ignored.");
+		ParameterInternalNames.Add("buffer");
+		ParameterDisplayNames.Add(FText::FromString("Buffer"));
+		ParameterDescriptions.Add(FText::FromString("The buffer you want to upload."));
+		ParameterInternalNames.Add("changed");
+		ParameterDisplayNames.Add(FText::FromString("Changed"));
+		ParameterDescriptions.Add(FText::FromString("The amount of cells which differed from the hidden screen buffer."));
+		Runtime = 2;
+	}
+
 	UFUNCTION()
 	void netFunc_getSize(int& w, int& h);
 	UFUNCTION()
@@ -455,13 +765,71 @@ public:
 		Runtime = 2;
 	}
 
+	UFUNCTION()
+	void netFunc_setFlushInterval(float interval);
+	UFUNCTION()
+    void netFuncMeta_setFlushInterval(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "setFlushInterval";
+		DisplayName = FText::FromString("Set Flush Interval");
+		Description = FText::FromString("Sets the minimum time between two flushes getting displayed on the screen. Flushes within that time get merged, so only the latest one gets displayed.");
+		ParameterInternalNames.Add("interval");
+		ParameterDisplayNames.Add(FText::FromString("Interval"));
+		ParameterDescriptions.Add(FText::FromString("The minimum time in seconds between two displayed flushes. (0.0 - 10.0)"));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	float netFunc_getFlushInterval();
+	UFUNCTION()
+    void netFuncMeta_getFlushInterval(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "getFlushInterval";
+		DisplayName = FText::FromString("Get Flush Interval");
+		Description = FText::FromString("Returns the minimum time between two flushes getting displayed on the screen.");
+		ParameterInternalNames.Add("interval");
+		ParameterDisplayNames.Add(FText::FromString("Interval"));
+		ParameterDescriptions.Add(FText::FromString("The minimum time in seconds between two displayed flushes."));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	void netFunc_getFlushStats(int& merged, int& dropped);
+	UFUNCTION()
+    void netFuncMeta_getFlushStats(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "getFlushStats";
+		DisplayName = FText::FromString("Get Flush Stats");
+		Description = FText::FromString("Returns how many flushes got merged into a later one and how many got dropped because nothing changed.");
+		ParameterInternalNames.Add("merged");
+		ParameterDisplayNames.Add(FText::FromString("Merged"));
+		ParameterDescriptions.Add(FText::FromString("The amount of flushes which got replaced by a later flush within the flush interval."));
+		ParameterInternalNames.Add("dropped");
+		ParameterDisplayNames.Add(FText::FromString("Dropped"));
+		ParameterDescriptions.Add(FText::FromString("The amount of flushes which got dropped because the hidden buffer did not change."));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	void netFunc_getInputStats(int& signaled, int& merged);
+	UFUNCTION()
+    void netFuncMeta_getInputStats(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "getInputStats";
+		DisplayName = FText::FromString("Get Input Stats");
+		Description = FText::FromString("Returns how many mouse and keyboard signals got emitted and how many mouse moves got merged because of the rate limit.");
+		ParameterInternalNames.Add("signaled");
+		ParameterDisplayNames.Add(FText::FromString("Signaled"));
+		ParameterDescriptions.Add(FText::FromString("The amount of mouse and keyboard signals emitted by this GPU."));
+		ParameterInternalNames.Add("merged");
+		ParameterDisplayNames.Add(FText::FromString("Merged"));
+		ParameterDescriptions.Add(FText::FromString("The amount of mouse moves which got replaced by a later mouse move."));
+		Runtime = 0;
+	}
+
 	UFUNCTION()
 	void netFunc_flush();
 	UFUNCTION()
     void netFuncMeta_flush(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
 		InternalName = "flush";
 		DisplayName = FText::FromString("Flush");
-		Description = FText::FromString("Flushes the hidden screen buffer to the visible screen buffer and so makes the draw calls visible.");
+		Description = FText::FromString("Flushes the hidden screen buffer to the visible screen buffer and so makes the draw calls visible. Flushes within the flush interval get merged and flushes without any changes get dropped.");
 		Runtime = 1;
 	}
 };
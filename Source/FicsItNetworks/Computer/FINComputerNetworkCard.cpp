@@ -3,8 +3,18 @@
 
 #include "UnrealNetwork.h"
 #include "Network/FINNetworkCircuit.h"
+#include "Network/FINNetworkCircuitSubsystem.h"
+#include "Network/FINNetworkUtils.h"
 #include "Network/Signals/FINSignalListener.h"
 #include "Reflection/FINReflection.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "FicsItNetworksModule.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Network Messages Sent"), STAT_FINNetworkMessagesSent, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Network Messages Received"), STAT_FINNetworkMessagesReceived, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Packed Network Messages Sent"), STAT_FINPackedNetworkMessagesSent, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Packed Network Message Bytes Sent"), STAT_FINPackedNetworkMessageBytesSent, STATGROUP_FicsItNetworks);
 
 void AFINComputerNetworkCard::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -28,7 +38,7 @@ void AFINComputerNetworkCard::BeginPlay() {
 
 	// setup circuit
 	if (!Circuit && HasAuthority()) {
-		Circuit = GetWorld()->SpawnActor<AFINNetworkCircuit>();
+		Circuit = AFINNetworkCircuitSubsystem::GetCircuitSubsystem(this)->CreateCircuit();
 		Circuit->Recalculate(this);
 	}
 }
@@ -49,6 +59,11 @@ FString AFINComputerNetworkCard::GetNick_Implementation() const {
 
 void AFINComputerNetworkCard::SetNick_Implementation(const FString& nick) {
 	Nick = nick;
+	UFINNetworkUtils::InvalidateNetworkComponentCache(this);
+}
+
+void AFINComputerNetworkCard::OnRep_Nick() {
+	UFINNetworkUtils::InvalidateNetworkComponentCache(this);
 }
 
 bool AFINComputerNetworkCard::HasNick_Implementation(const FString& nick) {
@@ -69,11 +84,11 @@ TSet<UObject*> AFINComputerNetworkCard::GetConnected_Implementation() const {
 	return Arr;
 }
 
-AFINNetworkCircuit* AFINComputerNetworkCard::GetCircuit_Implementation() const {
+UFINNetworkCircuit* AFINComputerNetworkCard::GetCircuit_Implementation() const {
 	return Circuit;
 }
 
-void AFINComputerNetworkCard::SetCircuit_Implementation(AFINNetworkCircuit* NewCircuit) {
+void AFINComputerNetworkCard::SetCircuit_Implementation(UFINNetworkCircuit* NewCircuit) {
 	Circuit = NewCircuit;
 }
 
@@ -83,7 +98,12 @@ bool AFINComputerNetworkCard::IsPortOpen(int Port) {
 	return OpenPorts.Contains(Port);
 }
 
-void AFINComputerNetworkCard::HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data) {
+bool AFINComputerNetworkCard::IsInGroup(int Group) {
+	return MulticastGroups.Contains(Group);
+}
+
+void AFINComputerNetworkCard::HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data, const FFINNetworkMessageRouting& Routing) {
+	if (!OpenPorts.Contains(Port) || (Routing.Group >= 0 && !MulticastGroups.Contains(Routing.Group))) return;
 	static UFINSignal* Signal = nullptr;
 	if (!Signal) Signal = FFINReflection::Get()->FindClass(StaticClass())->FindFINSignal("NetworkMessage");
 	{
@@ -91,8 +111,29 @@ void AFINComputerNetworkCard::HandleMessage(FGuid ID, FGuid Sender, FGuid Receiv
 		if (HandledMessages.Contains(ID) || !Signal) return;
 		HandledMessages.Add(ID);
 	}
+	INC_DWORD_STAT(STAT_FINNetworkMessagesReceived);
+
+	if (QueuedPorts.Contains(Port)) {
+		FFINNetworkCardMessage Message;
+		Message.Sender = Sender;
+		if (Routing.Packed.IsValid()) {
+			if (!UnpackNetMessageData(*Routing.Packed, Message.Data)) return;
+		} else {
+			Message.Data = Data;
+		}
+		FScopeLock Lock(&ReceiveQueuesMutex);
+		TArray<FFINNetworkCardMessage>& Queue = ReceiveQueues.FindOrAdd(Port);
+		if (Queue.Num() >= MaxQueuedMessages) Queue.RemoveAt(0, Queue.Num() - MaxQueuedMessages + 1, false);
+		Queue.Add(MoveTemp(Message));
+		return;
+	}
+	
 	TArray<FFINAnyNetworkValue> Parameters = { Sender.ToString(), (FINInt)Port };
-	Parameters.Append(Data);
+	if (Routing.Packed.IsValid()) {
+		if (!UnpackNetMessageData(*Routing.Packed, Parameters)) return;
+	} else {
+		Parameters.Append(Data);
+	}
 	Signal->Trigger(this, Parameters);
 }
 
@@ -118,6 +159,131 @@ bool AFINComputerNetworkCard::CheckNetMessageData(const TArray<FFINAnyNetworkVal
 	return true;
 }
 
+bool AFINComputerNetworkCard::PackNetMessageData(const TArray<FFINAnyNetworkValue>& Data, int MaxSize, TArray<uint8>& OutPacked) {
+	OutPacked.Reset();
+	FMemoryWriter Writer(OutPacked);
+	int32 Num = Data.Num();
+	Writer << Num;
+	for (const FFINAnyNetworkValue& Value : Data) {
+		uint8 Type = Value.GetType();
+		Writer << Type;
+		switch (Value.GetType()) {
+		case FIN_NIL:
+			break;
+		case FIN_BOOL: {
+			uint8 Bool = Value.GetBool() ? 1 : 0;
+			Writer << Bool;
+			break;
+		} case FIN_INT: {
+			int64 Int = Value.GetInt();
+			Writer << Int;
+			break;
+		} case FIN_FLOAT: {
+			double Float = Value.GetFloat();
+			Writer << Float;
+			break;
+		} case FIN_STR: {
+			FTCHARToUTF8 Conv(*Value.GetString(), Value.GetString().Len());
+			int32 Len = Conv.Length();
+			Writer << Len;
+			Writer.Serialize(const_cast<ANSICHAR*>(Conv.Get()), Len);
+			break;
+		} default:
+			return false;
+		}
+		if (OutPacked.Num() > MaxSize) return false;
+	}
+	return true;
+}
+
+bool AFINComputerNetworkCard::UnpackNetMessageData(const TArray<uint8>& Packed, TArray<FFINAnyNetworkValue>& OutData) {
+	FMemoryReader Reader(Packed);
+	int32 Num = 0;
+	Reader << Num;
+	if (Num < 0 || Num > Packed.Num()) return false;
+	OutData.Reserve(OutData.Num() + Num);
+	for (int i = 0; i < Num && !Reader.IsError(); ++i) {
+		uint8 Type = FIN_NIL;
+		Reader << Type;
+		switch (Type) {
+		case FIN_NIL:
+			OutData.Add(FFINAnyNetworkValue());
+			break;
+		case FIN_BOOL: {
+			uint8 Bool = 0;
+			Reader << Bool;
+			OutData.Add(static_cast<FINBool>(Bool != 0));
+			break;
+		} case FIN_INT: {
+			int64 Int = 0;
+			Reader << Int;
+			OutData.Add(static_cast<FINInt>(Int));
+			break;
+		} case FIN_FLOAT: {
+			double Float = 0;
+			Reader << Float;
+			OutData.Add(static_cast<FINFloat>(Float));
+			break;
+		} case FIN_STR: {
+			int32 Len = 0;
+			Reader << Len;
+			if (Len < 0 || Len > Reader.TotalSize() - Reader.Tell()) return false;
+			FUTF8ToTCHAR Conv(reinterpret_cast<const ANSICHAR*>(Packed.GetData() + Reader.Tell()), Len);
+			OutData.Add(FString(Conv.Length(), Conv.Get()));
+			Reader.Seek(Reader.Tell() + Len);
+			break;
+		} default:
+			return false;
+		}
+	}
+	return !Reader.IsError();
+}
+
+FGuid AFINComputerNetworkCard::NextMessageID() {
+	uint64 Sequence = FPlatformAtomics::InterlockedIncrement(&MessageSequence);
+	return FGuid(ID.A, ID.B, ID.C + static_cast<uint32>(Sequence >> 32), ID.D + static_cast<uint32>(Sequence));
+}
+
+void AFINComputerNetworkCard::SendMessage(const FGuid& Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data, TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Packed, int Group) {
+	FGuid MsgID = NextMessageID();
+	FGuid SenderID = Execute_GetID(this);
+	FFINNetworkMessageRouting Routing;
+	Routing.Group = Group;
+	Routing.Packed = Packed;
+	INC_DWORD_STAT(STAT_FINNetworkMessagesSent);
+	if (Packed.IsValid()) {
+		INC_DWORD_STAT(STAT_FINPackedNetworkMessagesSent);
+		INC_DWORD_STAT_BY(STAT_FINPackedNetworkMessageBytesSent, Packed->Num());
+	}
+	if (Group >= 0) {
+		for (UObject* Component : Circuit->GetComponents()) {
+			IFINNetworkMessageInterface* NetMsgI = Cast<IFINNetworkMessageInterface>(Component);
+			if (Component != this && NetMsgI && NetMsgI->IsInGroup(Group) && NetMsgI->IsPortOpen(Port)) {
+				NetMsgI->HandleMessage(MsgID, SenderID, Receiver, Port, Data, Routing);
+			}
+		}
+	} else if (Receiver.IsValid()) {
+		UObject* Obj = Circuit->FindComponent(Receiver, nullptr).GetObject();
+		IFINNetworkMessageInterface* NetMsgI = Cast<IFINNetworkMessageInterface>(Obj);
+		if (NetMsgI) {
+			if (NetMsgI->IsPortOpen(Port)) NetMsgI->HandleMessage(MsgID, SenderID, Receiver, Port, Data, Routing);
+		} else {
+			for (UObject* Router : Circuit->GetComponents()) {
+				IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(Router);
+				if (!MsgI || !MsgI->IsNetworkMessageRouter() || !MsgI->IsPortOpen(Port)) continue;
+				MsgI->HandleMessage(MsgID, SenderID, Receiver, Port, Data, Routing);
+			}
+		}
+	} else {
+		for (UObject* Component : Circuit->GetComponents()) {
+			IFINNetworkMessageInterface* NetMsgI = Cast<IFINNetworkMessageInterface>(Component);
+			if (NetMsgI && NetMsgI->IsPortOpen(Port)) {
+				NetMsgI->HandleMessage(MsgID, SenderID, Receiver, Port, Data, Routing);
+			}
+		}
+	}
+}
+
 void AFINComputerNetworkCard::netFunc_open(int port) {
 	if (port < 0 || port > 10000) return;
 	if (!OpenPorts.Contains(port)) OpenPorts.Add(port);
@@ -125,10 +291,50 @@ void AFINComputerNetworkCard::netFunc_open(int port) {
 
 void AFINComputerNetworkCard::netFunc_close(int port) {
 	OpenPorts.Remove(port);
+	QueuedPorts.Remove(port);
+	FScopeLock Lock(&ReceiveQueuesMutex);
+	ReceiveQueues.Remove(port);
 }
 
 void AFINComputerNetworkCard::netFunc_closeAll() {
 	OpenPorts.Empty();
+	QueuedPorts.Empty();
+	FScopeLock Lock(&ReceiveQueuesMutex);
+	ReceiveQueues.Empty();
+}
+
+void AFINComputerNetworkCard::netFunc_setQueued(int port, bool queued) {
+	if (port < 0 || port > 10000) return;
+	if (queued) {
+		QueuedPorts.Add(port);
+	} else {
+		QueuedPorts.Remove(port);
+		FScopeLock Lock(&ReceiveQueuesMutex);
+		ReceiveQueues.Remove(port);
+	}
+}
+
+TArray<FFINAnyNetworkValue> AFINComputerNetworkCard::netFunc_receive(int port, int count) {
+	TArray<FFINAnyNetworkValue> Messages;
+	FScopeLock Lock(&ReceiveQueuesMutex);
+	TArray<FFINNetworkCardMessage>* Queue = ReceiveQueues.Find(port);
+	if (!Queue || count <= 0) return Messages;
+	count = FMath::Min(count, Queue->Num());
+	Messages.Reserve(count);
+	for (int i = 0; i < count; ++i) {
+		FFINNetworkCardMessage& Message = (*Queue)[i];
+		TArray<FFINAnyNetworkValue> Entry = { Message.Sender.ToString() };
+		Entry.Append(MoveTemp(Message.Data));
+		Messages.Add(Entry);
+	}
+	Queue->RemoveAt(0, count, false);
+	return Messages;
+}
+
+int AFINComputerNetworkCard::netFunc_getQueueSize(int port) {
+	FScopeLock Lock(&ReceiveQueuesMutex);
+	TArray<FFINNetworkCardMessage>* Queue = ReceiveQueues.Find(port);
+	return Queue ? Queue->Num() : 0;
 }
 
 void AFINComputerNetworkCard::netFunc_send(FString receiver, int port, const TArray<FFINAnyNetworkValue>& args) {
@@ -136,29 +342,47 @@ void AFINComputerNetworkCard::netFunc_send(FString receiver, int port, const TAr
 
 	FGuid receiverID;
 	FGuid::Parse(receiver, receiverID);
-	UObject* Obj = Circuit->FindComponent(receiverID, nullptr).GetObject();
-	IFINNetworkMessageInterface* NetMsgI = Cast<IFINNetworkMessageInterface>(Obj);
-	FGuid MsgID = FGuid::NewGuid();
-	FGuid SenderID = Execute_GetID(this);
-	if (NetMsgI) {
-		if (NetMsgI->IsPortOpen(port)) NetMsgI->HandleMessage(MsgID, SenderID, receiverID, port, args);
-	} else {
-		for (UObject* Router : Circuit->GetComponents()) {
-			IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(Router);
-			if (!MsgI || !MsgI->IsNetworkMessageRouter() || !MsgI->IsPortOpen(port)) continue;
-			MsgI->HandleMessage(MsgID, SenderID, receiverID, port, args);
-		}
-	}
+	if (!receiverID.IsValid()) return;
+	SendMessage(receiverID, port, args);
 }
 
 void AFINComputerNetworkCard::netFunc_broadcast(int port, const TArray<FFINAnyNetworkValue>& args) {
  	if (!CheckNetMessageData(args) || port < 0 || port > 10000) return;
-	FGuid MsgID = FGuid::NewGuid();
-	FGuid SenderID = Execute_GetID(this);
-	for (UObject* Component : GetCircuit_Implementation()->GetComponents()) {
-		IFINNetworkMessageInterface* NetMsgI = Cast<IFINNetworkMessageInterface>(Component);
-		if (NetMsgI && NetMsgI->IsPortOpen(port)) {
-			NetMsgI->HandleMessage(MsgID, SenderID, FGuid(), port, args);
-		}
-	}
+	SendMessage(FGuid(), port, args);
+}
+
+void AFINComputerNetworkCard::netFunc_sendPacked(FString receiver, int port, const TArray<FFINAnyNetworkValue>& args) {
+	TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Packed = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+	if (!PackNetMessageData(args, MaxPackedMessageSize, *Packed) || port < 0 || port > 10000) return;
+
+	FGuid receiverID;
+	FGuid::Parse(receiver, receiverID);
+	if (!receiverID.IsValid()) return;
+	SendMessage(receiverID, port, {}, Packed);
+}
+
+void AFINComputerNetworkCard::netFunc_broadcastPacked(int port, const TArray<FFINAnyNetworkValue>& args) {
+	TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Packed = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+	if (!PackNetMessageData(args, MaxPackedMessageSize, *Packed) || port < 0 || port > 10000) return;
+	SendMessage(FGuid(), port, {}, Packed);
+}
+
+void AFINComputerNetworkCard::netFunc_joinGroup(int group) {
+	if (group < 0) return;
+	bool bAlreadyMember = false;
+	MulticastGroups.Add(group, &bAlreadyMember);
+	if (!bAlreadyMember) NotifyGroupsChanged();
+}
+
+void AFINComputerNetworkCard::netFunc_leaveGroup(int group) {
+	if (MulticastGroups.Remove(group) > 0) NotifyGroupsChanged();
+}
+
+void AFINComputerNetworkCard::netFunc_multicast(int group, int port, const TArray<FFINAnyNetworkValue>& args) {
+	if (!CheckNetMessageData(args) || group < 0 || port < 0 || port > 10000) return;
+	SendMessage(FGuid(), port, args, nullptr, group);
+}
+
+int AFINComputerNetworkCard::netFunc_getMaxPackedSize() {
+	return MaxPackedMessageSize;
 }
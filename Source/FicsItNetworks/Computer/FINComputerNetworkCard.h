@@ -9,6 +9,15 @@
 #include "FINComputerNetworkCard.generated.h"
 
 class AFINComputerCase;
+
+/**
+ * A network message received by a network card which waits in the receive queue of its port.
+ */
+struct FFINNetworkCardMessage {
+	FGuid Sender;
+	TArray<FFINAnyNetworkValue> Data;
+};
+
 UCLASS()
 class FICSITNETWORKS_API AFINComputerNetworkCard : public AFINComputerModule, public IFINNetworkCircuitNode, public IFINNetworkComponent, public IFINNetworkMessageInterface {
 	GENERATED_BODY()
@@ -18,6 +27,31 @@ public:
 	 */
 	UPROPERTY(SaveGame)
 	TSet<int> OpenPorts;
+
+	/**
+	 * List of open ports whose messages get put into the receive queue instead of getting emitted as signal.
+	 */
+	UPROPERTY(SaveGame)
+	TSet<int> QueuedPorts;
+
+	/**
+	 * List of multicast groups the network card is member of.
+	 */
+	UPROPERTY(SaveGame)
+	TSet<int> MulticastGroups;
+
+	/**
+	 * The receive queues of the queued ports.
+	 */
+	TMap<int, TArray<FFINNetworkCardMessage>> ReceiveQueues;
+	FCriticalSection ReceiveQueuesMutex;
+
+	/**
+	 * The max amount of messages the receive queue of a port can hold.
+	 * If the queue is full, the oldest message gets dropped.
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	int MaxQueuedMessages = 256;
 	
 	/**
 	* The ID of this computer network component.
@@ -31,9 +65,12 @@ public:
 	* The nick of this computer network component.
 	* Used to group components and give them an alias.
 	*/
-	UPROPERTY(SaveGame, Replicated)
+	UPROPERTY(SaveGame, ReplicatedUsing=OnRep_Nick)
 	FString Nick;
 
+	UFUNCTION()
+	void OnRep_Nick();
+
 	/**
 	* Used to check if the ID is already generated.
 	*/
@@ -51,7 +88,7 @@ public:
 	* The computer network circuit this component is connected to.
 	*/
 	UPROPERTY()
-	AFINNetworkCircuit* Circuit = nullptr;
+	UFINNetworkCircuit* Circuit = nullptr;
 
 	/**
 	 * Set of ID of already handled network messages since last tick.
@@ -60,6 +97,17 @@ public:
 	TSet<FGuid> HandledMessages;
 	FCriticalSection HandledMessagesMutex;
 
+	/**
+	 * The max size in bytes a packed network message is allowed to have.
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	int MaxPackedMessageSize = 8192;
+
+	/**
+	 * Counter used to generate the IDs of the messages sent by this network card.
+	 */
+	volatile int64 MessageSequence = 0;
+
 	AFINComputerNetworkCard();
 	
 	// Begin AActor
@@ -69,8 +117,8 @@ public:
 
 	// Begin IFINNetworkCircuitNode
 	virtual TSet<UObject*> GetConnected_Implementation() const override;
-	virtual AFINNetworkCircuit* GetCircuit_Implementation() const override;
-	virtual void SetCircuit_Implementation(AFINNetworkCircuit* Circuit) override;
+	virtual UFINNetworkCircuit* GetCircuit_Implementation() const override;
+	virtual void SetCircuit_Implementation(UFINNetworkCircuit* Circuit) override;
 	virtual void NotifyNetworkUpdate_Implementation(int Type, const TSet<UObject*>& Nodes) override;
 	// End IFINNetworkCircuitNodes
 	
@@ -85,11 +133,43 @@ public:
 
 	// Begin IFINNetworkMessageInterface
 	virtual bool IsPortOpen(int Port) override;
-	virtual void HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data) override;
+	virtual bool IsInGroup(int Group) override;
+	virtual void HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data, const FFINNetworkMessageRouting& Routing) override;
 	// End IFINNetworkMessageInterface
 
 	static bool CheckNetMessageData(const TArray<FFINAnyNetworkValue>& Data);
 
+	/**
+	 * Packs the given values into a byte array with a length prefixed binary layout.
+	 *
+	 * @param[in]	Data		the values you want to pack, only nil, booleans, numbers and strings are allowed
+	 * @param[in]	MaxSize		the max amount of bytes the packed data is allowed to have
+	 * @param[out]	OutPacked	the packed data
+	 * @return	false if the data contains values which can not get packed or if it exceeds the max size
+	 */
+	static bool PackNetMessageData(const TArray<FFINAnyNetworkValue>& Data, int MaxSize, TArray<uint8>& OutPacked);
+
+	/**
+	 * Unpacks the values of the given bytes packed with PackNetMessageData.
+	 *
+	 * @param[in]	Packed		the packed data
+	 * @param[out]	OutData		the unpacked values
+	 * @return	false if the packed data is malformed
+	 */
+	static bool UnpackNetMessageData(const TArray<uint8>& Packed, TArray<FFINAnyNetworkValue>& OutData);
+
+	/**
+	 * Generates a new unique message ID based on the ID of this network card and the message sequence counter.
+	 */
+	FGuid NextMessageID();
+
+	/**
+	 * Sends the given message data to the given receiver, or to all components if the receiver is not valid.
+	 * If a multicast group is given, the message gets only sent to the members of the group.
+	 * If packed data is given, it gets sent instead of the data values.
+	 */
+	void SendMessage(const FGuid& Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data, TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Packed = nullptr, int Group = -1);
+
 	UFUNCTION()
     void netClass_Meta(FString& InternalName, FText& DisplayName) {
 		InternalName = TEXT("NetworkCard");
@@ -132,6 +212,57 @@ public:
 		Runtime = 1;
 	}
 
+	UFUNCTION()
+	void netFunc_setQueued(int port, bool queued);
+	UFUNCTION()
+	void netFuncMeta_setQueued(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "setQueued";
+		DisplayName = FText::FromString("Set Port Queued");
+		Description = FText::FromString("Sets if the network messages received on the given port should get put into the receive queue of the port, instead of getting emitted as signals. The queued messages can then get read with the receive function.");
+		ParameterInternalNames.Add("port");
+		ParameterDisplayNames.Add(FText::FromString("Port"));
+		ParameterDescriptions.Add(FText::FromString("The port you want to change the mode of."));
+		ParameterInternalNames.Add("queued");
+		ParameterDisplayNames.Add(FText::FromString("Queued"));
+		ParameterDescriptions.Add(FText::FromString("True if the messages should get put into the receive queue, false if they should get emitted as signal."));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	TArray<FFINAnyNetworkValue> netFunc_receive(int port, int count);
+	UFUNCTION()
+	void netFuncMeta_receive(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "receive";
+		DisplayName = FText::FromString("Receive");
+		Description = FText::FromString("Removes up to the given amount of the oldest messages from the receive queue of the given port and returns them. Each message is an array containing the sender address as first entry, followed by the data of the message.");
+		ParameterInternalNames.Add("port");
+		ParameterDisplayNames.Add(FText::FromString("Port"));
+		ParameterDescriptions.Add(FText::FromString("The port of which you want to read the receive queue."));
+		ParameterInternalNames.Add("count");
+		ParameterDisplayNames.Add(FText::FromString("Count"));
+		ParameterDescriptions.Add(FText::FromString("The max amount of messages you want to receive."));
+		ParameterInternalNames.Add("messages");
+		ParameterDisplayNames.Add(FText::FromString("Messages"));
+		ParameterDescriptions.Add(FText::FromString("The received messages."));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	int netFunc_getQueueSize(int port);
+	UFUNCTION()
+	void netFuncMeta_getQueueSize(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "getQueueSize";
+		DisplayName = FText::FromString("Get Queue Size");
+		Description = FText::FromString("Returns the amount of messages waiting in the receive queue of the given port.");
+		ParameterInternalNames.Add("port");
+		ParameterDisplayNames.Add(FText::FromString("Port"));
+		ParameterDescriptions.Add(FText::FromString("The port of which you want to get the queue size."));
+		ParameterInternalNames.Add("size");
+		ParameterDisplayNames.Add(FText::FromString("Size"));
+		ParameterDescriptions.Add(FText::FromString("The amount of queued messages."));
+		Runtime = 1;
+	}
+
 	UFUNCTION()
 	void netFunc_send(FString receiver, int port, const TArray<FFINAnyNetworkValue>& varargs);
 	UFUNCTION()
@@ -161,6 +292,90 @@ public:
 		Runtime = 1;
 	}
 
+	UFUNCTION()
+	void netFunc_sendPacked(FString receiver, int port, const TArray<FFINAnyNetworkValue>& varargs);
+	UFUNCTION()
+	void netFuncMeta_sendPacked(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "sendPacked";
+		DisplayName = FText::FromString("Send Packed Message");
+		Description = FText::FromString("Sends a network message to the receiver with the given address on the given port. The data you want to add can be passed as additional parameters. The parameters get packed into a single binary payload, so there is no limit on the amount of parameters, but the packed size is not allowed to exceed the max message size of the network card. They can only be nil, booleans, numbers and strings. The receiver gets the parameters like with a regular message.");
+		ParameterInternalNames.Add("receiver");
+		ParameterDisplayNames.Add(FText::FromString("Receiver"));
+		ParameterDescriptions.Add(FText::FromString("The component ID as string of the component you want to send the network message to."));
+		ParameterInternalNames.Add("port");
+		ParameterDisplayNames.Add(FText::FromString("Port"));
+		ParameterDescriptions.Add(FText::FromString("The port on which the network message should get sent. For outgoing network messages a port does not need to be opened."));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	void netFunc_broadcastPacked(int port, const TArray<FFINAnyNetworkValue>& varargs);
+	UFUNCTION()
+	void netFuncMeta_broadcastPacked(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "broadcastPacked";
+		DisplayName = FText::FromString("Broadcast Packed Message");
+		Description = FText::FromString("Sends a network message to all components in the network message network (including networks sepperated by network routers) on the given port. The data you want to add can be passed as additional parameters. The parameters get packed into a single binary payload, so there is no limit on the amount of parameters, but the packed size is not allowed to exceed the max message size of the network card. They can only be nil, booleans, numbers and strings.");
+		ParameterInternalNames.Add("port");
+		ParameterDisplayNames.Add(FText::FromString("Port"));
+		ParameterDescriptions.Add(FText::FromString("The port on which the network message should get sent. For outgoing network messages a port does not need to be opened."));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	void netFunc_joinGroup(int group);
+	UFUNCTION()
+	void netFuncMeta_joinGroup(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "joinGroup";
+		DisplayName = FText::FromString("Join Group");
+		Description = FText::FromString("Joins the given multicast group so the network card receives the multicast messages sent to this group. The ports of the messages still need to be opened.");
+		ParameterInternalNames.Add("group");
+		ParameterDisplayNames.Add(FText::FromString("Group"));
+		ParameterDescriptions.Add(FText::FromString("The multicast group you want to join."));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	void netFunc_leaveGroup(int group);
+	UFUNCTION()
+	void netFuncMeta_leaveGroup(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "leaveGroup";
+		DisplayName = FText::FromString("Leave Group");
+		Description = FText::FromString("Leaves the given multicast group so the network card no longer receives the multicast messages sent to this group.");
+		ParameterInternalNames.Add("group");
+		ParameterDisplayNames.Add(FText::FromString("Group"));
+		ParameterDescriptions.Add(FText::FromString("The multicast group you want to leave."));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	void netFunc_multicast(int group, int port, const TArray<FFINAnyNetworkValue>& varargs);
+	UFUNCTION()
+	void netFuncMeta_multicast(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "multicast";
+		DisplayName = FText::FromString("Multicast Message");
+		Description = FText::FromString("Sends a network message to all components in the network message network (including networks sepperated by network routers) which are member of the given multicast group and have the given port opened. The data you want to add can be passed as additional parameters. Max amount of such parameters is 7 and they can only be nil, booleans, numbers and strings.");
+		ParameterInternalNames.Add("group");
+		ParameterDisplayNames.Add(FText::FromString("Group"));
+		ParameterDescriptions.Add(FText::FromString("The multicast group you want to send the network message to."));
+		ParameterInternalNames.Add("port");
+		ParameterDisplayNames.Add(FText::FromString("Port"));
+		ParameterDescriptions.Add(FText::FromString("The port on which the network message should get sent. For outgoing network messages a port does not need to be opened."));
+		Runtime = 1;
+	}
+
+	UFUNCTION()
+	int netFunc_getMaxPackedSize();
+	UFUNCTION()
+	void netFuncMeta_getMaxPackedSize(FString& InternalName, FText& DisplayName, FText& Description, TArray<FString>& ParameterInternalNames, TArray<FText>& ParameterDisplayNames, TArray<FText>& ParameterDescriptions, int32& Runtime) {
+		InternalName = "getMaxPackedSize";
+		DisplayName = FText::FromString("Get Max Packed Size");
+		Description = FText::FromString("Returns the max size in bytes the packed parameters of a packed network message are allowed to have.");
+		ParameterInternalNames.Add("size");
+		ParameterDisplayNames.Add(FText::FromString("Size"));
+		ParameterDescriptions.Add(FText::FromString("The max size in bytes of a packed message."));
+		Runtime = 1;
+	}
+
 	UFUNCTION()
 	void netSig_NetworkMessage(const FString& sender, int port, const TArray<FFINAnyNetworkValue>& varargs) {}
 	UFUNCTION()
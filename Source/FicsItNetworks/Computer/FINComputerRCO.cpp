@@ -53,17 +53,8 @@ bool UFINComputerRCO::SetNick_Validate(UObject* Component, const FString& Nick)
 }
 
 void UFINComputerRCO::GPUMouseEvent_Implementation(AFINComputerGPUT1* GPU, int type, int x, int y, int btn) {
-	switch (type) {
-	case 0:
-		GPU->netSig_OnMouseDown(x, y, btn);
-		break;
-	case 1:
-		GPU->netSig_OnMouseUp(x, y, btn);
-		break;
-	case 2:
-		GPU->netSig_OnMouseMove(x, y, btn);
-		break;
-	}
+	if (type < 0 || type > 2) return;
+	GPU->HandleInputEvents({FFINGPUT1InputEvent(type, x, y, btn)});
 }
 
 bool UFINComputerRCO::GPUMouseEvent_Validate(AFINComputerGPUT1* GPU, int type, int x, int y, int btn) {
@@ -71,20 +62,23 @@ bool UFINComputerRCO::GPUMouseEvent_Validate(AFINComputerGPUT1* GPU, int type, i
 }
 
 void UFINComputerRCO::GPUKeyEvent_Implementation(AFINComputerGPUT1* GPU, int type, int64 c, int64 code, int btn) {
-	switch (type) {
-	case 0:
-		GPU->netSig_OnKeyDown(c, code, btn);
-		break;
-	case 1:
-		GPU->netSig_OnKeyUp(c, code, btn);
-		break;
-	}
+	if (type < 0 || type > 1) return;
+	GPU->HandleInputEvents({FFINGPUT1InputEvent(type + 3, c, code, btn)});
 }
 
 bool UFINComputerRCO::GPUKeyEvent_Validate(AFINComputerGPUT1* GPU, int type, int64 c, int64 code, int btn) {
 	return true;
 }
 
+void UFINComputerRCO::GPUInputEvents_Implementation(AFINComputerGPUT1* GPU, const TArray<FFINGPUT1InputEvent>& Events) {
+	if (IsValid(GPU)) GPU->HandleInputEvents(Events);
+}
+
+bool UFINComputerRCO::GPUInputEvents_Validate(AFINComputerGPUT1* GPU, const TArray<FFINGPUT1InputEvent>& Events) {
+	// oversized batches get truncated by the GPU instead of disconnecting the client
+	return true;
+}
+
 void UFINComputerRCO::CreateEEPROMState_Implementation(UFGInventoryComponent* Inv, int SlotIdx) {
 	FInventoryStack stack;
 	if (!IsValid(Inv) || !Inv->GetStackFromIndex(SlotIdx, stack) || !IsValid(stack.Item.ItemClass)) return;
@@ -37,6 +37,9 @@ public:
 	UFUNCTION(BlueprintCallable, Server, WithValidation, Reliable, Category="Computer|RCO")
 	void GPUKeyEvent(AFINComputerGPUT1* GPU, int type, int64 c, int64 code, int btn);
 
+	UFUNCTION(Server, WithValidation, Reliable)
+	void GPUInputEvents(AFINComputerGPUT1* GPU, const TArray<FFINGPUT1InputEvent>& Events);
+
 	UFUNCTION(Server, WithValidation, Reliable)
 	void CreateEEPROMState(UFGInventoryComponent* Inv, int SlotIdx);
 };
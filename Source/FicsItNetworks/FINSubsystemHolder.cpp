@@ -4,4 +4,5 @@ void UFINSubsystemHolder::InitSubsystems() {
 	SpawnSubsystem(ComputerSubsystem, AFINComputerSubsystem::StaticClass(), "FINComputerSubsystem");
 	SpawnSubsystem(HookSubsystem, AFINHookSubsystem::StaticClass(), "FINHookSubsystem");
 	SpawnSubsystem(SignalSubsystem, AFINSignalSubsystem::StaticClass(), "FINSignalSubsystem");
+	SpawnSubsystem(CircuitSubsystem, AFINNetworkCircuitSubsystem::StaticClass(), "FINNetworkCircuitSubsystem");
 }
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Computer/FINComputerSubsystem.h"
 #include "Network/FINHookSubsystem.h"
+#include "Network/FINNetworkCircuitSubsystem.h"
 #include "Network/Signals/FINSignalSubsystem.h"
 #include "SML/mod/ModSubsystems.h"
 #include "FINSubsystemHolder.generated.h"
@@ -21,6 +22,9 @@ public:
 	UPROPERTY()
 	AFINSignalSubsystem* SignalSubsystem = nullptr;
 
+	UPROPERTY()
+	AFINNetworkCircuitSubsystem* CircuitSubsystem = nullptr;
+
 	// Begin UModSubsystemHolder
 	virtual void InitSubsystems() override;
 	// End UModSubsystemHolder
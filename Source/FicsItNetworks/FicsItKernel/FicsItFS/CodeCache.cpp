@@ -0,0 +1,82 @@
+#include "CodeCache.h"
+
+#include "FicsItNetworksModule.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Code Cache Hits"), STAT_FINCodeCacheHits, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Code Cache Misses"), STAT_FINCodeCacheMisses, STATGROUP_FicsItNetworks);
+DECLARE_MEMORY_STAT(TEXT("Code Cache Memory"), STAT_FINCodeCacheMemory, STATGROUP_FicsItNetworks);
+
+namespace FicsItKernel {
+	namespace FicsItFS {
+		static std::string CacheKey(FileSystem::Path path) {
+			path.absolute = true;
+			return path.str();
+		}
+
+		CodeCache::CodeCache(size_t maxBytes) : maxBytes(maxBytes) {}
+
+		CodeCache::~CodeCache() {
+			clear();
+		}
+
+		void CodeCache::invalidate(const FileSystem::Path& path) {
+			for (auto entry = entries.begin(); entry != entries.end();) {
+				if (FileSystem::Path(entry->first).startsWith(path)) {
+					usedBytes -= entry->second.chunk.size();
+					DEC_MEMORY_STAT_BY(STAT_FINCodeCacheMemory, entry->second.chunk.size());
+					entry = entries.erase(entry);
+				} else ++entry;
+			}
+		}
+
+		void CodeCache::onMounted(FileSystem::Path path, FileSystem::SRef<FileSystem::Device> device) {
+			invalidate(path);
+		}
+
+		void CodeCache::onUnmounted(FileSystem::Path path, FileSystem::SRef<FileSystem::Device> device) {
+			invalidate(path);
+		}
+
+		void CodeCache::onNodeAdded(FileSystem::Path path, FileSystem::NodeType type) {
+			invalidate(path);
+		}
+
+		void CodeCache::onNodeRemoved(FileSystem::Path path, FileSystem::NodeType type) {
+			invalidate(path);
+		}
+
+		void CodeCache::onNodeChanged(FileSystem::Path path, FileSystem::NodeType type) {
+			invalidate(path);
+		}
+
+		void CodeCache::onNodeRenamed(FileSystem::Path newPath, FileSystem::Path oldPath, FileSystem::NodeType type) {
+			invalidate(oldPath);
+			invalidate(newPath);
+		}
+
+		const std::string* CodeCache::find(const FileSystem::Path& path, size_t size, std::int64_t stamp) {
+			auto entry = entries.find(CacheKey(path));
+			if (entry == entries.end() || entry->second.size != size || entry->second.stamp != stamp) {
+				INC_DWORD_STAT(STAT_FINCodeCacheMisses);
+				return nullptr;
+			}
+			INC_DWORD_STAT(STAT_FINCodeCacheHits);
+			return &entry->second.chunk;
+		}
+
+		void CodeCache::store(const FileSystem::Path& path, size_t size, std::int64_t stamp, std::string chunk) {
+			if (chunk.size() > maxBytes) return;
+			invalidate(path);
+			if (usedBytes + chunk.size() > maxBytes) clear();
+			usedBytes += chunk.size();
+			INC_MEMORY_STAT_BY(STAT_FINCodeCacheMemory, chunk.size());
+			entries[CacheKey(path)] = {size, stamp, std::move(chunk)};
+		}
+
+		void CodeCache::clear() {
+			DEC_MEMORY_STAT_BY(STAT_FINCodeCacheMemory, usedBytes);
+			entries.clear();
+			usedBytes = 0;
+		}
+	}
+}
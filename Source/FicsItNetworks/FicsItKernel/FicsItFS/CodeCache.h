@@ -0,0 +1,70 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "Library/Listener.h"
+
+namespace FicsItKernel {
+	namespace FicsItFS {
+		/**
+		 * Caches compiled code chunks of files in the filesystem, keyed by path, file size and modification stamp.
+		 * Entries get invalidated by filesystem update events of the cached files.
+		 */
+		class FICSITNETWORKS_API CodeCache : public FileSystem::Listener {
+		private:
+			struct Entry {
+				size_t size;
+				std::int64_t stamp;
+				std::string chunk;
+			};
+
+			std::unordered_map<std::string, Entry> entries;
+			size_t usedBytes = 0;
+			size_t maxBytes;
+
+			/**
+			 * Removes all entries of the given path and its childs
+			 */
+			void invalidate(const FileSystem::Path& path);
+
+		public:
+			CodeCache(size_t maxBytes = 4 * 1024 * 1024);
+			virtual ~CodeCache();
+
+			// Begin FileSystem::Listener
+			virtual void onMounted(FileSystem::Path path, FileSystem::SRef<FileSystem::Device> device) override;
+			virtual void onUnmounted(FileSystem::Path path, FileSystem::SRef<FileSystem::Device> device) override;
+			virtual void onNodeAdded(FileSystem::Path path, FileSystem::NodeType type) override;
+			virtual void onNodeRemoved(FileSystem::Path path, FileSystem::NodeType type) override;
+			virtual void onNodeChanged(FileSystem::Path path, FileSystem::NodeType type) override;
+			virtual void onNodeRenamed(FileSystem::Path newPath, FileSystem::Path oldPath, FileSystem::NodeType type) override;
+			// End FileSystem::Listener
+
+			/**
+			 * Trys to find the cached chunk of the given file.
+			 * Counts as a hit in the code cache stats if found, otherwise as a miss.
+			 *
+			 * @param[in]	path	the path of the file
+			 * @param[in]	size	the current size of the file
+			 * @param[in]	stamp	the current modification stamp of the file
+			 * @return	the cached chunk, nullptr if there is no valid entry
+			 */
+			const std::string* find(const FileSystem::Path& path, size_t size, std::int64_t stamp);
+
+			/**
+			 * Stores the compiled chunk of the given file.
+			 *
+			 * @param[in]	path	the path of the file
+			 * @param[in]	size	the size of the file the chunk got compiled from
+			 * @param[in]	stamp	the modification stamp of the file the chunk got compiled from
+			 * @param[in]	chunk	the compiled chunk
+			 */
+			void store(const FileSystem::Path& path, size_t size, std::int64_t stamp, std::string chunk);
+
+			/**
+			 * Removes all entries
+			 */
+			void clear();
+		};
+	}
+}
@@ -29,13 +29,10 @@ void AFINFileSystemState::Serialize(FArchive& Ar) {
 	if (Ar.IsSaving()) {
 		if (dynamic_cast<FileSystem::MemDevice*>(Device.get())) node.NodeType = 3;
 		if (dynamic_cast<FileSystem::DiskDevice*>(Device.get())) node.NodeType = 2;
-		if (node.NodeType == 2 || node.NodeType == 3) {
-			std::unordered_set<FileSystem::NodeName> nodes = Device->childs("");
-			for (FileSystem::NodeName newNode : nodes) {
-				TSharedPtr<FFileSystemNode> newSerializeNode = MakeShareable(new FFileSystemNode());
-				newSerializeNode->Serialize(Device, newNode);
-				node.ChildNodes.Add(FString(newNode.c_str()), newSerializeNode);
-			}
+		if ((node.NodeType == 2 || node.NodeType == 3) && SaveCache.isValid()) {
+			// reads the disk again, in case PreSaveGame didn't already
+			SaveCache->Snapshot();
+			node.ChildNodes = SaveCache->GetNode()->ChildNodes;
 		}
 	}
 	
@@ -60,6 +57,11 @@ bool AFINFileSystemState::ShouldSave_Implementation() const {
 	return true;
 }
 
+void AFINFileSystemState::PreSaveGame_Implementation(int32 gameVersion, int32 engineVersion) {
+	// read the disk now, so the encoding can run while the other actors get saved
+	if (SaveCache.isValid()) SaveCache->Snapshot();
+}
+
 FileSystem::SRef<FileSystem::Device> AFINFileSystemState::GetDevice() {
 	if (!HasAuthority()) return nullptr;
 	
@@ -76,6 +78,8 @@ FileSystem::SRef<FileSystem::Device> AFINFileSystemState::GetDevice() {
 		std::filesystem::create_directories(root);
 
 		Device = new FileSystem::DiskDevice(root, Capacity);
+		SaveCache = new FFileSystemNodeCache(Device);
+		Device->addListener(SaveCache);
 	}
 	return Device;
 }
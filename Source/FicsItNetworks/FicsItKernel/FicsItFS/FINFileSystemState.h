@@ -12,6 +12,7 @@ class FICSITNETWORKS_API AFINFileSystemState : public AActor, public IFGSaveInte
 
 private:
 	FileSystem::SRef<FileSystem::Device> Device;
+	FileSystem::SRef<FFileSystemNodeCache> SaveCache;
 	
 public:
 	UPROPERTY(SaveGame)
@@ -41,6 +42,7 @@ public:
 
 	// Begin IFGSaveInterface
 	virtual bool ShouldSave_Implementation() const override;
+	virtual void PreSaveGame_Implementation(int32 gameVersion, int32 engineVersion) override;
 	// End IFGSaveInterface
 	
 	FileSystem::SRef<FileSystem::Device> GetDevice();
@@ -8,6 +8,10 @@
 
 namespace FicsItKernel {
 	namespace FicsItFS {
+		Root::Root() : codeCache(new CodeCache()) {
+			addListener(codeCache);
+		}
+
 		bool Root::mount(FileSystem::SRef<FileSystem::Device> device, FileSystem::Path path) {
 			// if device is DevDevice, search for existing DevDevice in mounts & prevent mount if found
 			if (dynamic_cast<DevDevice*>(device.get())) {
@@ -65,6 +69,49 @@ namespace FicsItKernel {
 			return "";
 		}
 
+		int Root::startTransfer(FileSystem::Path from, FileSystem::Path to, bool recursive, bool move) {
+			FileSystem::SRef<FileSystem::FileTransfer> transfer = FileSystemRoot::transfer(from, to, recursive, move);
+			if (!transfer.isValid()) return 0;
+			int handle = nextTransferHandle++;
+			transferHandles[handle] = transfer;
+			return handle;
+		}
+
+		FileSystem::SRef<FileSystem::FileTransfer> Root::getTransfer(int handle) {
+			auto transfer = transferHandles.find(handle);
+			if (transfer == transferHandles.end()) return nullptr;
+			FileSystem::SRef<FileSystem::FileTransfer> ref = transfer->second;
+			if (ref->isDone()) transferHandles.erase(transfer);
+			return ref;
+		}
+
+		bool Root::getFileStamp(FileSystem::Path path, size_t& size, std::int64_t& stamp) {
+			FileSystem::Path pending;
+			FileSystem::SRef<FileSystem::Device> device = getDevice(path, pending);
+			if (!device.isValid()) return false;
+			if (FileSystem::DiskDevice* disk = dynamic_cast<FileSystem::DiskDevice*>(device.get())) {
+				std::filesystem::path realPath = disk->getRealPath() / pending;
+				try {
+					if (!std::filesystem::is_regular_file(realPath)) return false;
+					size = std::filesystem::file_size(realPath);
+					stamp = std::filesystem::last_write_time(realPath).time_since_epoch().count();
+				} catch (...) {
+					return false;
+				}
+				return true;
+			}
+			FileSystem::SRef<FileSystem::MemFile> file = device->get(pending);
+			if (!file.isValid()) return false;
+			// mem files only change through the filesystem, so the cache gets invalidated by the update events
+			size = file->getSize();
+			stamp = 0;
+			return true;
+		}
+
+		CodeCache& Root::getCodeCache() {
+			return *codeCache;
+		}
+
 		std::string Root::persistPath(FileSystem::Path path) {
 			FileSystem::Path pending;
 			FileSystem::SRef<FileSystem::Device> dev = getDevice(path, pending);
@@ -124,7 +171,44 @@ namespace FicsItKernel {
 			return false;
 		}
 
+		FileSystem::SRef<FFileSystemNodeCache> Root::getSaveCache(const FileSystem::NodeName& name, FileSystem::SRef<FileSystem::Device> device) {
+			FileSystem::SRef<FFileSystemNodeCache>& cache = saveCaches[name];
+			if (!cache.isValid() || cache->GetDevice() != device) {
+				if (cache.isValid() && cache->GetDevice().isValid()) cache->GetDevice()->removeListener(cache);
+				cache = new FFileSystemNodeCache(device);
+				device->addListener(cache);
+			}
+			return cache;
+		}
+
+		void Root::pruneSaveCaches() {
+			FileSystem::SRef<DevDevice> devDev = getDevDevice();
+			std::unordered_map<FileSystem::NodeName, FileSystem::SRef<FileSystem::Device>> devices;
+			if (devDev.isValid()) devices = devDev->getDevices();
+			for (auto cache = saveCaches.begin(); cache != saveCaches.end();) {
+				FileSystem::SRef<FileSystem::Device> device = cache->second->GetDevice();
+				auto dev = devices.find(cache->first);
+				if (dev != devices.end() && dev->second == device) {
+					++cache;
+				} else {
+					if (device.isValid()) device->removeListener(cache->second);
+					cache = saveCaches.erase(cache);
+				}
+			}
+		}
+
+		void Root::PreSerialize(bool bLoading) {
+			if (!bLoading) pruneSaveCaches();
+			FileSystem::SRef<DevDevice> devDev = getDevDevice();
+			if (bLoading || !devDev.isValid()) return;
+			for (std::pair<const FileSystem::NodeName, FileSystem::SRef<FileSystem::Device>> dev : devDev->getDevices()) {
+				if (!dynamic_cast<FileSystem::MemDevice*>(dev.second.get())) continue;
+				getSaveCache(dev.first, dev.second)->Snapshot();
+			}
+		}
+
 		void Root::Serialize(FArchive& Ar, FFileSystemSerializationInfo& info) {
+			if (Ar.IsSaving()) pruneSaveCaches();
 			if (Ar.IsSaving() && getDevDevice()) {
 				// serialize mount points
 				for (auto mount : mounts) {
@@ -139,7 +223,9 @@ namespace FicsItKernel {
 				// serialize tempfs
 				for (std::pair<const FileSystem::NodeName, FileSystem::SRef<FileSystem::Device>> dev : getDevDevice()->getDevices()) {
 					if (!dynamic_cast<FileSystem::MemDevice*>(dev.second.get())) continue;
-					FFileSystemNode node = FFileSystemNode().Serialize(dev.second, "/");
+					FileSystem::SRef<FFileSystemNodeCache> cache = getSaveCache(dev.first, dev.second);
+					cache->Snapshot();
+					FFileSystemNode node = *cache->GetNode();
 					node.NodeType = 3;
 					info.Devices.Add(dev.first.c_str(), node);
 				}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Library/FileSystemRoot.h"
+#include "CodeCache.h"
 #include "DevDevice.h"
 #include "FileSystemSerializationInfo.h"
 
@@ -15,7 +16,25 @@ namespace FicsItKernel {
 		 * - preventing a seccond DevDevice to get mounted
 		 */
 		class FICSITNETWORKS_API Root : public FileSystem::FileSystemRoot {
+		private:
+			std::map<int, FileSystem::SRef<FileSystem::FileTransfer>> transferHandles;
+			int nextTransferHandle = 1;
+			FileSystem::SRef<CodeCache> codeCache;
+			std::unordered_map<FileSystem::NodeName, FileSystem::SRef<FFileSystemNodeCache>> saveCaches;
+
+			/**
+			 * Gets the save cache of the given device, creates a new one if the device has none yet.
+			 */
+			FileSystem::SRef<FFileSystemNodeCache> getSaveCache(const FileSystem::NodeName& name, FileSystem::SRef<FileSystem::Device> device);
+
+			/**
+			 * Removes the save caches of devices which got removed from the DevDevice.
+			 */
+			void pruneSaveCaches();
+
 		public:
+			Root();
+
 			// Begin FileSystemRoot
 			bool mount(FileSystem::SRef<FileSystem::Device> device, FileSystem::Path path);
 			bool unmount(FileSystem::Path path);
@@ -52,6 +71,42 @@ namespace FicsItKernel {
 			 */
 			FileSystem::Path getMountPoint(FileSystem::SRef<DevDevice> device);
 
+			/**
+			 * Starts a transfer and returns a handle which can be used to query its progress.
+			 *
+			 * @param[in]	from		path to the node you want to copy/move
+			 * @param[in]	to			path to the node you want to copy/move to
+			 * @param[in]	recursive	true if you want to copy a folder and its content
+			 * @param[in]	move		true if the source should get removed after the copy
+			 * @return	the handle of the transfer, 0 if it was not able to start the transfer
+			 */
+			int startTransfer(FileSystem::Path from, FileSystem::Path to, bool recursive, bool move);
+
+			/**
+			 * Gets the transfer with the given handle.
+			 * Once a finished transfer got queried, the handle gets released.
+			 *
+			 * @param[in]	handle	the handle of the transfer
+			 * @return	the transfer, nullptr if the handle is not valid
+			 */
+			FileSystem::SRef<FileSystem::FileTransfer> getTransfer(int handle);
+
+			/**
+			 * Gets the size and modification stamp of the file at the given path
+			 * without opening the file.
+			 *
+			 * @param[in]	path	the path to the file
+			 * @param[out]	size	the size of the file
+			 * @param[out]	stamp	the modification stamp of the file, 0 for files which don't have one
+			 * @return	false if there is no file at the given path
+			 */
+			bool getFileStamp(FileSystem::Path path, size_t& size, std::int64_t& stamp);
+
+			/**
+			 * Returns the cache of compiled code chunks of this filesystem.
+			 */
+			CodeCache& getCodeCache();
+
 			/**
 			 * Converts the given path into a string which is persistable.
 			 *
@@ -76,6 +131,15 @@ namespace FicsItKernel {
 			 */
 			bool checkUnpersistPath(std::string path);
 
+			/**
+			 * Prepares the serialization of the filesystem.
+			 * When saving, reads the tmpfs nodes changed since the last save
+			 * and encodes them in the background.
+			 *
+			 * @param[in]	bLoading	true if the filesystem gets deserialized
+			 */
+			void PreSerialize(bool bLoading);
+
 			/**
 			 * Serializes the filesystem to an archive.
 			 * Only sores mount points & tmpfs
@@ -1,6 +1,7 @@
 ﻿#include "FileSystemSerializationInfo.h"
 
 #include "FicsItNetworksModule.h"
+#include "Async/Async.h"
 
 bool FFileSystemNodeIndex::Serialize(FArchive& Ar) {
 	bool valid = Node.IsValid();
@@ -104,6 +105,127 @@ FArchive& operator<<(FArchive& Ar, FFileSystemNode& Node) {
 	return Ar;
 }
 
+FFileSystemNodeCache::FFileSystemNodeCache(FileSystem::SRef<FileSystem::Device> Device) : Device(Device) {}
+
+FFileSystemNodeCache::~FFileSystemNodeCache() {
+	if (Encoding.IsValid()) Encoding.Wait();
+}
+
+void FFileSystemNodeCache::onNodeAdded(FileSystem::Path path, FileSystem::NodeType type) {
+	Dirty.insert(path);
+}
+
+void FFileSystemNodeCache::onNodeRemoved(FileSystem::Path path, FileSystem::NodeType type) {
+	Dirty.insert(path);
+}
+
+void FFileSystemNodeCache::onNodeChanged(FileSystem::Path path, FileSystem::NodeType type) {
+	Dirty.insert(path);
+}
+
+void FFileSystemNodeCache::onNodeRenamed(FileSystem::Path newPath, FileSystem::Path oldPath, FileSystem::NodeType type) {
+	Dirty.insert(newPath);
+	Dirty.insert(oldPath);
+}
+
+void FFileSystemNodeCache::ReadSnapshot(FileSystem::SRef<FileSystem::Device> Device, const FileSystem::Path& Path, FSnapshot& OutSnapshot) {
+	const FileSystem::SRef<FileSystem::Node> node = Device->get(Path);
+	if (FileSystem::SRef<FileSystem::File> file = node) {
+		FileSystem::SRef<FileSystem::FileStream> stream = file->open(FileSystem::INPUT);
+		if (!stream.isValid()) return;
+		OutSnapshot.NodeType = 0;
+		OutSnapshot.Data = stream->readAll();
+		stream->close();
+	} else if (FileSystem::SRef<FileSystem::Directory> dir = node) {
+		OutSnapshot.NodeType = 1;
+		for (FileSystem::NodeName child : dir->getChilds()) {
+			OutSnapshot.ChildNodes.emplace_back(child, FSnapshot());
+			ReadSnapshot(Device, Path / child, OutSnapshot.ChildNodes.back().second);
+		}
+	}
+}
+
+TSharedPtr<FFileSystemNode> FFileSystemNodeCache::Encode(const FSnapshot& Snapshot) {
+	TSharedPtr<FFileSystemNode> Node = MakeShareable(new FFileSystemNode());
+	Node->NodeType = Snapshot.NodeType;
+	if (Snapshot.NodeType == 0) {
+		Node->Data = FString(UTF8_TO_TCHAR(Snapshot.Data.c_str()), Snapshot.Data.length());
+	} else {
+		for (const std::pair<std::string, FSnapshot>& Child : Snapshot.ChildNodes) {
+			if (Child.second.NodeType < 0) continue;
+			Node->ChildNodes.Add(Child.first.c_str(), Encode(Child.second));
+		}
+	}
+	return Node;
+}
+
+void FFileSystemNodeCache::Apply(FFileSystemNode& Root, FileSystem::Path Path, const FSnapshot& Snapshot) {
+	if (Path.getNodeCount() < 1) {
+		Root.ChildNodes = Encode(Snapshot)->ChildNodes;
+		return;
+	}
+	FFileSystemNode* Parent = &Root;
+	while (!Path.isFinal()) {
+		FString Name = Path.getRoot().c_str();
+		FFileSystemNodeIndex* Child = Parent->ChildNodes.Find(Name);
+		if (!Child || !Child->Node.IsValid()) {
+			TSharedPtr<FFileSystemNode> Dir = MakeShareable(new FFileSystemNode());
+			Dir->NodeType = 1;
+			Child = &Parent->ChildNodes.Add(Name, Dir);
+		}
+		Parent = Child->Node.Get();
+		Path = Path.next();
+	}
+	FString Name = Path.getRoot().c_str();
+	if (Snapshot.NodeType < 0) Parent->ChildNodes.Remove(Name);
+	else Parent->ChildNodes.Add(Name, Encode(Snapshot));
+}
+
+void FFileSystemNodeCache::Snapshot() {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_FINFileSystemNodeCache_Snapshot);
+	
+	GetNode();
+	FileSystem::SRef<FileSystem::Device> device = Device;
+	if (!device.isValid()) return;
+
+	// changes of a disk are only reported by the OS watcher, which may miss or delay them,
+	// so disks always get read completely to not lose any data
+	if (!Root.IsValid() || dynamic_cast<FileSystem::DiskDevice*>(device.get())) {
+		if (!Root.IsValid()) Root = MakeShareable(new FFileSystemNode());
+		Dirty = {FileSystem::Path()};
+	}
+	if (Dirty.empty()) return;
+
+	// the set is ordered, so parents come before their childs and changed childs of changed parents can get skipped
+	TSharedPtr<std::vector<std::pair<FileSystem::Path, FSnapshot>>> Snapshots = MakeShared<std::vector<std::pair<FileSystem::Path, FSnapshot>>>();
+	for (const FileSystem::Path& path : Dirty) {
+		if (!Snapshots->empty() && path.startsWith(Snapshots->back().first)) continue;
+		Snapshots->emplace_back(path, FSnapshot());
+		ReadSnapshot(device, path, Snapshots->back().second);
+	}
+	Dirty.clear();
+
+	TSharedPtr<FFileSystemNode> Node = Root;
+	Encoding = Async(EAsyncExecution::ThreadPool, [Node, Snapshots]() {
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_FINFileSystemNodeCache_Encode);
+		for (const std::pair<FileSystem::Path, FSnapshot>& Snapshot : *Snapshots) {
+			Apply(*Node, Snapshot.first, Snapshot.second);
+		}
+	});
+}
+
+TSharedPtr<FFileSystemNode> FFileSystemNodeCache::GetNode() {
+	if (Encoding.IsValid()) {
+		Encoding.Wait();
+		Encoding = TFuture<void>();
+	}
+	return Root;
+}
+
+FileSystem::SRef<FileSystem::Device> FFileSystemNodeCache::GetDevice() const {
+	return Device;
+}
+
 bool FFileSystemSerializationInfo::Serialize(FArchive& Ar) {
 	Ar << Mounts;
 	Ar << Devices;
@@ -1,7 +1,10 @@
 ﻿#pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 #include "Library/Device.h"
+
+#include <set>
 #include "FileSystemSerializationInfo.generated.h"
 
 struct FFileSystemNode;
@@ -72,6 +75,61 @@ struct TStructOpsTypeTraits<FFileSystemNode> : TStructOpsTypeTraitsBase2<FFileSy
     };
 };
 
+/**
+ * Keeps the serialized node tree of a device between saves and tracks which nodes changed since the last save,
+ * so a save only has to read the changed nodes from the device again.
+ * Disk devices always get read completely, because the OS doesn't reliably report their changes.
+ * The changed nodes get read on the game thread, but get encoded into the node tree on a worker thread.
+ * Add it as listener to the device so it gets notified about changes.
+ */
+class FICSITNETWORKS_API FFileSystemNodeCache : public FileSystem::Listener {
+private:
+	struct FSnapshot {
+		int NodeType = -1;
+		std::string Data;
+		std::vector<std::pair<std::string, FSnapshot>> ChildNodes;
+	};
+
+	FileSystem::WRef<FileSystem::Device> Device;
+	TSharedPtr<FFileSystemNode> Root;
+	std::set<FileSystem::Path> Dirty;
+	TFuture<void> Encoding;
+
+	static void ReadSnapshot(FileSystem::SRef<FileSystem::Device> Device, const FileSystem::Path& Path, FSnapshot& OutSnapshot);
+	static TSharedPtr<FFileSystemNode> Encode(const FSnapshot& Snapshot);
+	static void Apply(FFileSystemNode& Root, FileSystem::Path Path, const FSnapshot& Snapshot);
+
+public:
+	FFileSystemNodeCache(FileSystem::SRef<FileSystem::Device> Device);
+	virtual ~FFileSystemNodeCache();
+
+	// Begin FileSystem::Listener
+	virtual void onNodeAdded(FileSystem::Path path, FileSystem::NodeType type) override;
+	virtual void onNodeRemoved(FileSystem::Path path, FileSystem::NodeType type) override;
+	virtual void onNodeChanged(FileSystem::Path path, FileSystem::NodeType type) override;
+	virtual void onNodeRenamed(FileSystem::Path newPath, FileSystem::Path oldPath, FileSystem::NodeType type) override;
+	// End FileSystem::Listener
+
+	/**
+	 * Reads all nodes changed since the last snapshot from the device, or the whole device if it is a disk,
+	 * and starts encoding them into the node tree on a worker thread.
+	 * Does nothing if no node changed.
+	 * @note	ONLY FROM THE MAIN THREAD!!!
+	 */
+	void Snapshot();
+
+	/**
+	 * Waits for the running encoding and returns the node of the device root.
+	 * The node contains the state of the device at the last snapshot.
+	 */
+	TSharedPtr<FFileSystemNode> GetNode();
+
+	/**
+	 * Returns the device this cache is tracking
+	 */
+	FileSystem::SRef<FileSystem::Device> GetDevice() const;
+};
+
 USTRUCT()
 struct FICSITNETWORKS_API FFileSystemSerializationInfo {
 	GENERATED_BODY()
@@ -41,6 +41,10 @@ namespace FileSystem {
 		listeners.erase(listener);
 	}
 
+	bool Device::move(Path from, Path to) {
+		return false;
+	}
+
 	bool ByteCountedDevice::checkSizeFunc(long long size, bool addIfAble) {
 		if (capacity < 1) return true;
 		size_t newUsed = getUsed();
@@ -63,6 +67,10 @@ namespace FileSystem {
 		return used;
 	}
 
+	bool ByteCountedDevice::reserve(long long size) {
+		return checkSize(size, true);
+	}
+
 	size_t getSizeFromNode(SRef<Node> node) {
 		size_t count = 0;
 		Node* n = node.get();
@@ -159,23 +167,13 @@ namespace FileSystem {
 		return getSizeFromPath(realPath);
 	}
 
-	DiskDevice::DiskDevice(fs::path realPath, size_t capacity) : ByteCountedDevice(capacity), realPath(realPath), watcher(realPath,
-		[&](int eventType, auto node, auto to, auto from) {
-			switch (eventType) {
-			case 0:
-				listeners.onNodeAdded(to, node);
-				break;
-			case 1:
-				listeners.onNodeRemoved(to, node);
-				break;
-			case 2:
-				listeners.onNodeChanged(to, node);
-				break;
-			case 3:
-				listeners.onNodeRenamed(to, from, node);
-				break;
-			}
-		}) {
+	DiskDevice::DiskDevice(fs::path realPath, size_t capacity) : ByteCountedDevice(capacity), realPath(realPath), coalescer(realPath)
+#if PLATFORM_WINDOWS || PLATFORM_LINUX
+		, watcher(realPath, [this](int eventType, NodeType node, Path to, Path from) {
+			coalescer.push(eventType, node, to, from);
+		})
+#endif
+	{
 		getUsed();
 	}
 
@@ -220,6 +218,18 @@ namespace FileSystem {
 		return true;
 	}
 
+	bool DiskDevice::move(Path from, Path to) {
+		if (from.getNodeCount() < 1 || to.getNodeCount() < 1) return false;
+		if (!fs::exists(realPath / from) || fs::exists(realPath / to) || !fs::is_directory(realPath / to.prev())) return false;
+		try {
+			fs::rename(realPath / from, realPath / to);
+		} catch (...) {
+			return false;
+		}
+		tickWatcher();
+		return true;
+	}
+
 	SRef<Node> DiskDevice::get(Path path) {
 		if (path.getNodeCount() < 1) return new DiskDirectory(realPath, checkSize);
 		if (fs::is_regular_file(realPath / path)) {
@@ -238,7 +248,25 @@ namespace FileSystem {
 	}
 
 	void DiskDevice::tickWatcher() {
+#if PLATFORM_WINDOWS || PLATFORM_LINUX
 		watcher.tick();
+#endif
+		coalescer.flush([this](int eventType, NodeType node, Path to, Path from) {
+			switch (eventType) {
+			case 0:
+				listeners.onNodeAdded(to, node);
+				break;
+			case 1:
+				listeners.onNodeRemoved(to, node);
+				break;
+			case 2:
+				listeners.onNodeChanged(to, node);
+				break;
+			case 3:
+				listeners.onNodeRenamed(to, from, node);
+				break;
+			}
+		});
 	}
 
 	std::filesystem::path DiskDevice::getRealPath() const {
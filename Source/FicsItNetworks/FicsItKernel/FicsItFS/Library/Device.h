@@ -3,13 +3,24 @@
 #include "File.h"
 #include "Directory.h"
 #include "Listener.h"
+#include "FileWatcherCoalescer.h"
+#if PLATFORM_WINDOWS
 #include "WindowsFileWatcher.h"
+#elif PLATFORM_LINUX
+#include "LinuxFileWatcher.h"
+#endif
 
 #include <unordered_set>
 
 namespace FileSystem {
 	class FileSystemRoot;
 
+#if PLATFORM_WINDOWS
+	typedef WindowsFileWatcher FileWatcher;
+#elif PLATFORM_LINUX
+	typedef LinuxFileWatcher FileWatcher;
+#endif
+
 	typedef std::function<bool(long long, bool)> SizeCheckFunc;
 
 	class Device : virtual public ReferenceCounted {
@@ -71,6 +82,17 @@ namespace FileSystem {
 		*/
 		virtual std::unordered_set<NodeName> childs(Path path) = 0;
 
+		/*
+		* trys to move the node at the given path to the other given path within this device
+		* without copying the content, f.e. by using a rename of the underlying storage.
+		* The target path has to point to a not existing node in an existing directory.
+		*
+		* @param[in]	from	path to the node you want to move
+		* @param[in]	to		path the node should get moved to
+		* @return	returns true if the device was able to move the node, false if the caller has to fall back to a copy
+		*/
+		virtual bool move(Path from, Path to);
+
 		/*
 		* Adds the given FileSystem-Listener to the listeners list.
 		* The listener gets automatically removed when a event occurs and the reference is invalid.
@@ -129,6 +151,14 @@ namespace FileSystem {
 		* @return	the use space
 		*/
 		size_t getUsed();
+
+		/*
+		* trys to reserve the given amount of bytes for data written to the device without a file stream
+		*
+		* @param[in]	size	the amount of bytes you want to write, negative to free space again
+		* @return	false if the device doesnt have enough capacity left
+		*/
+		bool reserve(long long size);
 	};
 
 	class MemDevice : public ByteCountedDevice {
@@ -153,7 +183,10 @@ namespace FileSystem {
 	class DiskDevice : public ByteCountedDevice {
 	private:
 		std::filesystem::path realPath;
-		WindowsFileWatcher watcher;
+		FileWatcherCoalescer coalescer;
+#if PLATFORM_WINDOWS || PLATFORM_LINUX
+		FileWatcher watcher;
+#endif
 
 	protected:
 		virtual size_t getSize() const override;
@@ -167,9 +200,11 @@ namespace FileSystem {
 		virtual bool rename(Path path, const NodeName& name) override;
 		virtual SRef<Node> get(Path path) override;
 		virtual std::unordered_set<NodeName> childs(Path path) override;
+		virtual bool move(Path from, Path to) override;
 
 		/*
 		* calls all event changes since device creation or last call
+		* multiple changes of the same node get merged into one event
 		*/
 		void tickWatcher();
 
@@ -1,5 +1,6 @@
 #include "File.h"
 
+#include <algorithm>
 #include <experimental/filesystem>
 
 using namespace std;
@@ -44,6 +45,22 @@ FileMode FileStream::getMode() const {
 	return mode;
 }
 
+void FileStream::write(const char* data, size_t length) {
+	write(std::string(data, length));
+}
+
+const char* FileStream::peekChars(size_t chars, size_t& length) {
+	return nullptr;
+}
+
+const char* FileStream::readLineBuffered(size_t& length) {
+	return nullptr;
+}
+
+const char* FileStream::peekAll(size_t& length) {
+	return nullptr;
+}
+
 FileStream& FileStream::operator<<(const std::string& str) {
 	write(str);
 
@@ -62,11 +79,14 @@ MemFileStream::~MemFileStream() {
 }
 
 void MemFileStream::write(string newData) {
+	write(newData.c_str(), newData.length());
+}
+
+void MemFileStream::write(const char* newData, size_t length) {
 	if (!isOpen()) throw std::exception("filestream not open");
 	if (!sizeCheck(buf.length(), true)) throw std::exception("out of memory");
-	buf = buf.erase(pos, newData.length());
-	buf.insert(pos, newData);
-	pos += newData.length();
+	buf.replace(pos, length, newData, length);
+	pos += length;
 }
 
 void MemFileStream::flush() {
@@ -131,6 +151,39 @@ bool MemFileStream::isEOF() {
 	return pos >= static_cast<int64_t>(buf.length());
 }
 
+const char* MemFileStream::peekChars(size_t chars, size_t& length) {
+	if (!isOpen()) throw std::exception("filestream not open");
+	if (!(mode & FileMode::INPUT)) throw std::exception("filestream not in input mode");
+	if (pos >= static_cast<int64_t>(buf.length())) {
+		length = 0;
+		return buf.c_str();
+	}
+	length = std::min(chars, buf.length() - pos);
+	return buf.c_str() + pos;
+}
+
+const char* MemFileStream::readLineBuffered(size_t& length) {
+	if (!isOpen()) throw std::exception("filestream not open");
+	if (!(mode & FileMode::INPUT)) throw std::exception("filestream not in input mode");
+	if (pos >= static_cast<int64_t>(buf.length())) {
+		length = 0;
+		return buf.c_str();
+	}
+	size_t end = buf.find('\n', pos);
+	if (end == string::npos) end = buf.length();
+	length = end - pos;
+	const char* line = buf.c_str() + pos;
+	pos += length;
+	return line;
+}
+
+const char* MemFileStream::peekAll(size_t& length) {
+	if (!isOpen()) throw std::exception("filestream not open");
+	if (!(mode & FileMode::INPUT)) throw std::exception("filestream not in input mode");
+	length = buf.length();
+	return buf.c_str();
+}
+
 bool MemFileStream::isOpen() {
 	return open;
 }
@@ -170,11 +223,14 @@ DiskFileStream::DiskFileStream(filesystem::path realPath, FileMode mode, SizeChe
 DiskFileStream::~DiskFileStream() {}
 
 void DiskFileStream::write(string data) {
+	write(data.c_str(), data.length());
+}
+
+void DiskFileStream::write(const char* data, size_t length) {
 	if (!isOpen()) throw std::exception("filestream not open");
-	if (!sizeCheck(data.length(), true)) throw std::exception("out of capacity");
-	buf = buf.erase(pos, data.length());
-	buf.insert(pos, data);
-	pos += data.length();
+	if (!sizeCheck(length, true)) throw std::exception("out of capacity");
+	buf.replace(pos, length, data, length);
+	pos += length;
 }
 
 void DiskFileStream::flush() {
@@ -241,6 +297,39 @@ bool DiskFileStream::isEOF() {
 	return stream.eof();
 }
 
+const char* DiskFileStream::peekChars(size_t chars, size_t& length) {
+	if (!isOpen()) throw std::exception("filestream not open");
+	if (!(mode & FileMode::INPUT)) throw std::exception("filestream not in input mode");
+	if (pos >= static_cast<int64_t>(buf.length())) {
+		length = 0;
+		return buf.c_str();
+	}
+	length = std::min(chars, buf.length() - pos);
+	return buf.c_str() + pos;
+}
+
+const char* DiskFileStream::readLineBuffered(size_t& length) {
+	if (!isOpen()) throw std::exception("filestream not open");
+	if (!(mode & FileMode::INPUT)) throw std::exception("filestream not in input mode");
+	if (pos >= static_cast<int64_t>(buf.length())) {
+		length = 0;
+		return buf.c_str();
+	}
+	size_t end = buf.find('\n', pos);
+	if (end == string::npos) end = buf.length();
+	length = end - pos;
+	const char* line = buf.c_str() + pos;
+	pos += length;
+	return line;
+}
+
+const char* DiskFileStream::peekAll(size_t& length) {
+	if (!isOpen()) throw std::exception("filestream not open");
+	if (!(mode & FileMode::INPUT)) throw std::exception("filestream not in input mode");
+	length = buf.length();
+	return buf.c_str();
+}
+
 bool DiskFileStream::isOpen() {
 	return stream.is_open();
 }
@@ -84,6 +84,15 @@ namespace FileSystem {
 		*/
 		virtual void write(std::string str) = 0;
 
+		/*
+		* Writes the given data to the current output-stream at the output-stream pos
+		* without the need of constructing a string first.
+		*
+		* @param[in]	data	pointer to the data you want to write to the stream
+		* @param[in]	length	the length of the data
+		*/
+		virtual void write(const char* data, size_t length);
+
 		/*
 		* "Saves" the changes of the stream to the actual file
 		*/
@@ -146,6 +155,37 @@ namespace FileSystem {
 		*/
 		virtual bool isOpen() = 0;
 
+		/*
+		* gives direct access to the given amount of characters of the input-stream at the current input-stream pos.
+		* Works like readChars but without copying the data.
+		* The returned data is only valid until the next call to the stream.
+		*
+		* @param[in]	chars	the count of chars you want to read
+		* @param[out]	length	the count of chars actually available
+		* @return	pointer to the chars, nullptr if the stream has no internal buffer and readChars has to be used instead
+		*/
+		virtual const char* peekChars(size_t chars, size_t& length);
+
+		/*
+		* reads the line of the input-stream at the current input-stream pos and gives direct access to it.
+		* Works like readLine, so it moves the input-stream pos past the line, but without copying the data.
+		* The returned data is only valid until the next call to the stream.
+		*
+		* @param[out]	length	the length of the line
+		* @return	pointer to the line, nullptr if the stream has no internal buffer and readLine has to be used instead
+		*/
+		virtual const char* readLineBuffered(size_t& length);
+
+		/*
+		* gives direct access to the whole content of the input-stream.
+		* Works like readAll but without copying the data.
+		* The returned data is only valid until the next call to the stream.
+		*
+		* @param[out]	length	the length of the content
+		* @return	pointer to the content, nullptr if the stream has no internal buffer and readAll has to be used instead
+		*/
+		virtual const char* peekAll(size_t& length);
+
 		/**
 		 * Writes the given string to the stream.
 		 *
@@ -168,6 +208,7 @@ namespace FileSystem {
 		~MemFileStream();
 
 		virtual void write(std::string str);
+		virtual void write(const char* data, size_t length);
 		virtual void flush();
 		virtual std::string readChars(size_t chars);
 		virtual std::string readLine();
@@ -177,6 +218,9 @@ namespace FileSystem {
 		virtual void close();
 		virtual bool isEOF();
 		virtual bool isOpen();
+		virtual const char* peekChars(size_t chars, size_t& length);
+		virtual const char* readLineBuffered(size_t& length);
+		virtual const char* peekAll(size_t& length);
 	};
 
 	class DiskFileStream : public FileStream {
@@ -192,6 +236,7 @@ namespace FileSystem {
 		~DiskFileStream();
 
 		virtual void write(std::string str);
+		virtual void write(const char* data, size_t length);
 		virtual void flush();
 		virtual std::string readChars(size_t chars);
 		virtual std::string readLine();
@@ -201,5 +246,8 @@ namespace FileSystem {
 		virtual void close();
 		virtual bool isEOF();
 		virtual bool isOpen();
+		virtual const char* peekChars(size_t chars, size_t& length);
+		virtual const char* readLineBuffered(size_t& length);
+		virtual const char* peekAll(size_t& length);
 	};
 }
\ No newline at end of file
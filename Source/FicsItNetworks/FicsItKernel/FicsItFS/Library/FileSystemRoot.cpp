@@ -42,6 +42,7 @@ FileSystemRoot& FileSystem::FileSystemRoot::operator=(FileSystemRoot&& other) {
 	listeners = other.listeners;
 	listener = other.listener;
 	listener->root = this;
+	transfers = other.transfers;
 	return *this;
 }
 
@@ -91,120 +92,106 @@ bool FileSystemRoot::rename(Path path, const NodeName& name) {
 	return true;
 }
 
-int FileSystemRoot::copy(Path from, Path to, bool recursive) {
-	Path pendingFrom = "";
-	Path pendingTo = "";
-	auto deviceFrom = getDevice(from, pendingFrom);
-	if (!deviceFrom.isValid()) return 1;
-	auto deviceTo = getDevice(to, pendingTo);
-	if (!deviceTo.isValid()) return 1;
-	
-	auto f = deviceFrom->get(pendingFrom);
-	auto t = deviceTo->get(pendingTo);
-
-	if (!recursive && dynamic_cast<Directory*>(f.get())) return 1;
-
-	if (!t.isValid()) {
-		SRef<Directory> prevT = deviceTo->get(pendingTo.prev());
-		if (!prevT.isValid()) return 1;
-		if (dynamic_cast<File*>(f.get())) {
-			t = prevT->createFile(pendingTo.getFinal());
-		} else if (dynamic_cast<Directory*>(f.get())) {
-			t = prevT->createSubdir(pendingTo.getFinal());
-		}
-	} else if (from.getFinal() != to.getFinal()) {
-		SRef<Directory> tDir = t;
-		if (tDir.isValid()) {
-			t = tDir->createSubdir(from.getFinal());
-			to = to / from.getFinal();
-		}
+bool FileSystemRoot::resolveTransfer(Path from, Path to, SRef<Device>& deviceFrom, Path& pendingFrom, SRef<Device>& deviceTo, Path& pendingTo) {
+	if (from.getNodeCount() < 1) return false;
+	deviceFrom = getDevice(from, pendingFrom);
+	if (!deviceFrom.isValid()) return false;
+	deviceTo = getDevice(to, pendingTo);
+	if (!deviceTo.isValid()) return false;
+
+	if (!deviceFrom->get(pendingFrom).isValid()) return false;
+	SRef<Node> t = deviceTo->get(pendingTo);
+	if (t.isValid()) {
+		if (!dynamic_cast<Directory*>(t.get()) || from.getFinal() == to.getFinal()) return false;
+		pendingTo = pendingTo / from.getFinal();
+		if (deviceTo->get(pendingTo).isValid()) return false;
 	}
-	if (!t.isValid()) return 1;
+	return dynamic_cast<Directory*>(deviceTo->get(pendingTo.prev()).get());
+}
 
-	SRef<Directory> tDir = t;
-	SRef<File> tFile = t;
-	if (tDir.isValid()) {
-		SRef<Directory> fDir = f;
-		if (!fDir.isValid()) return 1;
-		bool ret = true;
-		for (auto& child : fDir->getChilds()) {
-			if (copy(from / child, to / child)) ret = false;
-		}
-		return ret ? 0 : 2;
-	} else if (tFile.isValid()) {
-		auto ofs = tFile->open(OUTPUT);
-		auto ifs = f->open(INPUT);
-		if (!ofs.isValid() || !ifs.isValid()) return 1;
-		ofs->write(ifs->readAll());
-		ofs->close();
-	}
-	return 1;
+bool FileSystemRoot::moveNative(SRef<Device> deviceFrom, Path from, SRef<Device> deviceTo, Path to) {
+	return deviceFrom == deviceTo && deviceFrom->move(from, to);
 }
 
-int FileSystemRoot::moveInternal(Path from, Path to) {
-	Path pendingFrom = "";
-	Path pendingTo = "";
-	auto deviceFrom = getDevice(from, pendingFrom);
-	if (!deviceFrom.isValid()) return 1;
-	auto deviceTo = getDevice(to, pendingTo);
-	if (!deviceTo.isValid()) return 1;
-
-	auto f = deviceFrom->get(pendingFrom);
-	auto t = deviceTo->get(pendingTo);
-
-	if (!t.isValid()) {
-		SRef<Directory> prevT = deviceTo->get(pendingTo.prev());
-		if (!prevT.isValid()) return 1;
-		if (dynamic_cast<File*>(f.get())) {
-			t = prevT->createFile(pendingTo.getFinal());
-		} else if (dynamic_cast<Directory*>(f.get())) {
-			t = prevT->createSubdir(pendingTo.getFinal());
+bool FileSystemRoot::buildTransfer(FileTransfer& transfer, SRef<Device> deviceFrom, Path from, SRef<Device> deviceTo, Path to) {
+	SRef<Node> f = deviceFrom->get(from);
+	if (dynamic_cast<Directory*>(f.get())) {
+		if (!deviceTo->createDir(to).isValid()) return false;
+		bool ret = true;
+		for (auto& child : f->getChilds()) {
+			if (!buildTransfer(transfer, deviceFrom, from / child, deviceTo, to / child)) ret = false;
 		}
-	} else if (from.getFinal() != to.getFinal()) {
-		SRef<Directory> tDir = t;
-		if (tDir.isValid()) {
-			if (dynamic_cast<File*>(f.get())) {
-				t = tDir->createFile(from.getFinal());
-			} else if (dynamic_cast<Directory*>(f.get())) {
-				t = tDir->createSubdir(from.getFinal());
-			}
-			to = to / from.getFinal();
+		return ret;
+	} else if (dynamic_cast<File*>(f.get())) {
+		size_t size = 0;
+		if (MemFile* memFile = dynamic_cast<MemFile*>(f.get())) {
+			size = memFile->getSize();
+		} else if (DiskDevice* disk = dynamic_cast<DiskDevice*>(deviceFrom.get())) {
+			try {
+				size = std::filesystem::file_size(disk->getRealPath() / from);
+			} catch (...) {}
 		}
+		transfer.add({deviceFrom, from, deviceTo, to}, size);
+		return true;
 	}
-	if (!t.isValid()) return 1;
+	return false;
+}
 
-	SRef<Directory> tDir = t;
-	SRef<File> tFile = t;
-	if (tDir.isValid()) {
-		SRef<Directory> fDir = f;
-		if (!fDir.isValid()) return 1;
-		bool ret = true;
-		for (auto& child : fDir->getChilds()) {
-			bool able = moveInternal(from / child, to / child) > 0;
-			if (!able) ret = false;
-		}
-		if (ret) remove(from, true);
-		return ret ? 0 : 2;
-	} else if (tFile.isValid()) {
-		auto ofs = tFile->open(OUTPUT);
-		auto ifs = f->open(INPUT);
-		if (!ofs.isValid() || !ifs.isValid()) return 1;
-		ofs->write(ifs->readAll());
-		ofs->close();
-		ifs->close();
-		return remove(from, false);
-	}
-	return 1;
+int FileSystemRoot::copy(Path from, Path to, bool recursive) {
+	SRef<Device> deviceFrom, deviceTo;
+	Path pendingFrom = "", pendingTo = "";
+	if (!resolveTransfer(from, to, deviceFrom, pendingFrom, deviceTo, pendingTo)) return 1;
+	if (!recursive && dynamic_cast<Directory*>(deviceFrom->get(pendingFrom).get())) return 1;
+
+	FileTransfer transfer;
+	bool built = buildTransfer(transfer, deviceFrom, pendingFrom, deviceTo, pendingTo);
+	bool copied = transfer.run();
+	if (built && copied) return 0;
+	return transfer.getBytesCopied() > 0 ? 2 : 1;
 }
 
 int FileSystemRoot::move(Path from, Path to) {
-	if (from.getNodeCount() < 1) return 1;
-	Path pendingFrom = "";
-	auto deviceFrom = getDevice(from.prev(), pendingFrom);
-	if (!deviceFrom.isValid()) return 1;
-	auto prevFrom = deviceFrom->get(pendingFrom);
-	if (!prevFrom.isValid()) return 1;
-	return moveInternal(from, to);
+	SRef<Device> deviceFrom, deviceTo;
+	Path pendingFrom = "", pendingTo = "";
+	if (!resolveTransfer(from, to, deviceFrom, pendingFrom, deviceTo, pendingTo)) return 1;
+	if (moveNative(deviceFrom, pendingFrom, deviceTo, pendingTo)) return 0;
+
+	FileTransfer transfer;
+	bool built = buildTransfer(transfer, deviceFrom, pendingFrom, deviceTo, pendingTo);
+	bool copied = transfer.run();
+	if (built && copied) {
+		remove(from, true);
+		return 0;
+	}
+	return transfer.getBytesCopied() > 0 ? 2 : 1;
+}
+
+SRef<FileTransfer> FileSystemRoot::transfer(Path from, Path to, bool recursive, bool move) {
+	SRef<Device> deviceFrom, deviceTo;
+	Path pendingFrom = "", pendingTo = "";
+	if (!resolveTransfer(from, to, deviceFrom, pendingFrom, deviceTo, pendingTo)) return nullptr;
+	if (!recursive && !move && dynamic_cast<Directory*>(deviceFrom->get(pendingFrom).get())) return nullptr;
+
+	SRef<FileTransfer> transfer = new FileTransfer();
+	if (move && moveNative(deviceFrom, pendingFrom, deviceTo, pendingTo)) return transfer;
+
+	bool built = buildTransfer(*transfer, deviceFrom, pendingFrom, deviceTo, pendingTo);
+	if (move) transfer->setOnFinished([built, deviceFrom, pendingFrom](bool success) {
+		if (built && success) deviceFrom->remove(pendingFrom, true);
+	});
+	transfers.push_back(transfer);
+	return transfer;
+}
+
+void FileSystemRoot::tickTransfers(size_t budget) {
+	for (auto i = transfers.begin(); i != transfers.end();) {
+		size_t copied = (*i)->getBytesCopied();
+		bool done = (*i)->step(budget);
+		budget -= std::min(budget, (*i)->getBytesCopied() - copied);
+		if (done) i = transfers.erase(i);
+		else if (budget < 1) break;
+		else ++i;
+	}
 }
 
 SRef<Node> FileSystemRoot::get(Path path) {
@@ -5,6 +5,7 @@
 
 #include "Directory.h"
 #include "Device.h"
+#include "FileTransfer.h"
 
 namespace FileSystem {
 	class FileSystemException : public std::exception {
@@ -36,6 +37,7 @@ namespace FileSystem {
 		std::map<Path, SRef<Node>> cache;
 		ListenerList listeners;
 		SRef<RootListener> listener;
+		std::vector<SRef<FileTransfer>> transfers;
 
 		/*
 		* gets the device managing the given path based on mounts
@@ -46,7 +48,34 @@ namespace FileSystem {
 		*/
 		SRef<Device> getDevice(Path path, Path& pending);
 
-		int moveInternal(Path from, Path to);
+		/*
+		* resolves the devices of a copy or move and the final target path.
+		* if the target is an existing directory, the source node gets placed into it.
+		*
+		* @param[in]	from			the path to the node you want to copy/move
+		* @param[in]	to				the path you want to copy/move the node to
+		* @param[out]	deviceFrom		the device managing the source node
+		* @param[out]	pendingFrom		the source path relative to the source device
+		* @param[out]	deviceTo		the device managing the target node
+		* @param[out]	pendingTo		the final target path relative to the target device
+		* @return	false if the source or target are not valid
+		*/
+		bool resolveTransfer(Path from, Path to, SRef<Device>& deviceFrom, Path& pendingFrom, SRef<Device>& deviceTo, Path& pendingTo);
+
+		/*
+		* tries to move the node natively using the device, f.e. by a rename of the underlying storage.
+		* copies and moves between devices always go through a chunked transfer.
+		*
+		* @return	true if it was able to move the node natively
+		*/
+		bool moveNative(SRef<Device> deviceFrom, Path from, SRef<Device> deviceTo, Path to);
+
+		/*
+		* creates the target directory tree and adds all files of the source to the given transfer
+		*
+		* @return	false if it was not able to create the target tree
+		*/
+		bool buildTransfer(FileTransfer& transfer, SRef<Device> deviceFrom, Path from, SRef<Device> deviceTo, Path to);
 
 	public:
 		FileSystemRoot();
@@ -106,15 +135,34 @@ namespace FileSystem {
 
 		/*
 		* moves the from node to the to node
-		* basicaly copies from to to and removes from afterwards
+		* uses a native move if both paths are on the same device,
+		* otherwise copies from to to and removes from afterwards
 		*
 		* @param[in]	from		path to the node you want to move to somewere else
 		* @param[in]	to			path to the node you want the from node into
-		* @param[in]	recursive	true if you want to move a folder and its content
 		* @return	0 if move worked, 1 if was filly not able to move and 2 if it was able to move partially
 		*/
 		int move(Path from, Path to);
 
+		/*
+		* starts a copy or move of the from node to the to node which gets processed over multiple calls of tickTransfers.
+		* native moves are done immediately and return an already finished transfer.
+		*
+		* @param[in]	from		path to the node you want to copy/move
+		* @param[in]	to			path to the node you want to copy/move to
+		* @param[in]	recursive	true if you want to copy a folder and its content
+		* @param[in]	move		true if the source should get removed after a successful copy
+		* @return	the started transfer, nullptr if it was not able to start the transfer
+		*/
+		SRef<FileTransfer> transfer(Path from, Path to, bool recursive, bool move);
+
+		/*
+		* continues the running transfers and removes finished ones
+		*
+		* @param[in]	budget	the max amount of bytes all transfers are allowed to copy
+		*/
+		void tickTransfers(size_t budget);
+
 		/*
 		* trys to get the node at the given path
 		*
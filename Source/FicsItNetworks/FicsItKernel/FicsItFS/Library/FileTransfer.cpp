@@ -0,0 +1,152 @@
+#include "FileTransfer.h"
+
+#include <cstring>
+
+using namespace std;
+using namespace FileSystem;
+
+FileTransfer::FileTransfer(size_t chunkSize) : chunkSize(chunkSize > 0 ? chunkSize : 1) {}
+
+FileTransfer::~FileTransfer() {
+	closeCurrent();
+}
+
+void FileTransfer::add(const Entry& entry, size_t size) {
+	pending.push_back(entry);
+	bytesTotal += size;
+}
+
+void FileTransfer::setOnFinished(std::function<void(bool)> func) {
+	onFinished = func;
+}
+
+bool FileTransfer::openNext() {
+	while (!pending.empty()) {
+		Entry entry = pending.front();
+		pending.pop_front();
+		try {
+			if (DiskDevice* disk = dynamic_cast<DiskDevice*>(entry.fromDevice.get())) {
+				realInput.open(disk->getRealPath() / entry.from, std::ios::in | std::ios::binary);
+			} else {
+				input = entry.fromDevice->open(entry.from, INPUT);
+			}
+			if (DiskDevice* disk = dynamic_cast<DiskDevice*>(entry.toDevice.get())) {
+				if (disk->get(entry.to.prev()).isValid()) {
+					realOutput.open(disk->getRealPath() / entry.to, std::ios::out | std::ios::trunc | std::ios::binary);
+					realOutputDevice = entry.toDevice;
+				}
+			} else {
+				output = entry.toDevice->open(entry.to, OUTPUT | TRUNC);
+			}
+		} catch (...) {
+			input = nullptr;
+			output = nullptr;
+		}
+		if ((input.isValid() || realInput.is_open()) && (output.isValid() || realOutput.is_open())) return true;
+		closeCurrent();
+		failed = true;
+	}
+	return false;
+}
+
+void FileTransfer::closeCurrent() {
+	try {
+		if (input.isValid()) input->close();
+		if (output.isValid()) output->close();
+	} catch (...) {
+		failed = true;
+	}
+	input = nullptr;
+	output = nullptr;
+	if (realInput.is_open()) realInput.close();
+	realInput.clear();
+	if (realOutput.is_open()) {
+		realOutput.close();
+		if (realOutput.fail()) failed = true;
+	}
+	realOutput.clear();
+	realOutputDevice = nullptr;
+}
+
+bool FileTransfer::hasInput() const {
+	return input.isValid() || realInput.is_open();
+}
+
+size_t FileTransfer::readChunk(size_t max) {
+	if (buffer.size() < max) buffer.resize(max);
+	if (realInput.is_open()) {
+		realInput.read(buffer.data(), max);
+		if (realInput.bad()) throw std::exception("unable to read file");
+		return static_cast<size_t>(realInput.gcount());
+	}
+	size_t length = 0;
+	const char* data = input->peekChars(max, length);
+	std::string chunk;
+	if (!data) {
+		chunk = input->readChars(max);
+		data = chunk.c_str();
+		length = chunk.length();
+	}
+	memcpy(buffer.data(), data, length);
+	input->seek("cur", length);
+	return length;
+}
+
+void FileTransfer::writeChunk(size_t length) {
+	if (realOutput.is_open()) {
+		if (!realOutputDevice->reserve(length)) throw std::exception("out of capacity");
+		realOutput.write(buffer.data(), length);
+		if (realOutput.fail()) throw std::exception("unable to write file");
+		return;
+	}
+	output->write(buffer.data(), length);
+}
+
+bool FileTransfer::step(size_t budget) {
+	while (budget > 0) {
+		if (!hasInput() && !openNext()) break;
+		size_t length = 0;
+		try {
+			length = readChunk(std::min(budget, chunkSize));
+			if (length < 1) {
+				closeCurrent();
+				continue;
+			}
+			writeChunk(length);
+		} catch (...) {
+			failed = true;
+			closeCurrent();
+			continue;
+		}
+		bytesCopied += length;
+		budget -= length;
+	}
+	if (!isDone()) return false;
+	if (onFinished) {
+		auto func = onFinished;
+		onFinished = nullptr;
+		func(!failed);
+	}
+	return true;
+}
+
+bool FileTransfer::run() {
+	while (!step(chunkSize));
+	return !failed;
+}
+
+bool FileTransfer::isDone() const {
+	return pending.empty() && !hasInput();
+}
+
+bool FileTransfer::hasFailed() const {
+	return failed;
+}
+
+size_t FileTransfer::getBytesCopied() const {
+	return bytesCopied;
+}
+
+size_t FileTransfer::getBytesTotal() const {
+	return std::max(bytesTotal, bytesCopied);
+}
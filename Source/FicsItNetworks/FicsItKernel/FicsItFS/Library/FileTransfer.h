@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <vector>
+
+#include "Device.h"
+
+namespace FileSystem {
+	/*
+	* Copies files from one device to another in chunks of a bounded size.
+	* The transfer can get stepped multiple times, so large copies are able to span multiple ticks
+	* without ever holding more than one chunk in the transfer buffer.
+	* Files of disk devices get read and written directly through the real file,
+	* since the device file streams load the whole file into memory.
+	*/
+	class FileTransfer : public ReferenceCounted {
+	public:
+		struct Entry {
+			SRef<Device> fromDevice;
+			Path from;
+			SRef<Device> toDevice;
+			Path to;
+		};
+
+	protected:
+		std::deque<Entry> pending;
+		SRef<FileStream> input;
+		SRef<FileStream> output;
+		std::ifstream realInput;
+		std::ofstream realOutput;
+		SRef<ByteCountedDevice> realOutputDevice;
+		std::vector<char> buffer;
+		size_t chunkSize;
+		size_t bytesTotal = 0;
+		size_t bytesCopied = 0;
+		bool failed = false;
+		std::function<void(bool)> onFinished;
+
+		/*
+		* opens the streams of the next pending entry
+		*
+		* @return	false if there are no more entries
+		*/
+		bool openNext();
+
+		/*
+		* closes the currently open streams
+		*/
+		void closeCurrent();
+
+		/*
+		* checks if there is a currently open input stream
+		*/
+		bool hasInput() const;
+
+		/*
+		* reads the next chunk of the current input into the buffer
+		*
+		* @param[in]	max		the max amount of bytes to read
+		* @return	the amount of bytes read, 0 if the input reached its end
+		*/
+		size_t readChunk(size_t max);
+
+		/*
+		* writes the first bytes of the buffer to the current output
+		*
+		* @param[in]	length	the amount of bytes to write
+		*/
+		void writeChunk(size_t length);
+
+	public:
+		FileTransfer(size_t chunkSize = 64 * 1024);
+		virtual ~FileTransfer();
+
+		/*
+		* adds the file at the given path in the from device to the transfer queue.
+		*
+		* @param[in]	entry	the source and target of the file copy
+		* @param[in]	size	the expected size of the file, used for progress reporting
+		*/
+		void add(const Entry& entry, size_t size);
+
+		/*
+		* sets the function which gets called once the transfer finished
+		*
+		* @param[in]	func	called with true if all files got copied successfully
+		*/
+		void setOnFinished(std::function<void(bool)> func);
+
+		/*
+		* copies up to the given amount of bytes
+		*
+		* @param[in]	budget	the max amount of bytes you want to copy in this step
+		* @return	true if the transfer is finished
+		*/
+		bool step(size_t budget);
+
+		/*
+		* runs the transfer until it is finished
+		*
+		* @return	true if all files got copied successfully
+		*/
+		bool run();
+
+		/*
+		* checks if there are no more bytes to copy
+		*
+		* @return	true if the transfer is finished
+		*/
+		bool isDone() const;
+
+		/*
+		* checks if any of the file copies failed
+		*
+		* @return	true if at least one file was not able to get copied
+		*/
+		bool hasFailed() const;
+
+		/*
+		* returns the amount of bytes already copied
+		*/
+		size_t getBytesCopied() const;
+
+		/*
+		* returns the amount of bytes the transfer expects to copy in total
+		*/
+		size_t getBytesTotal() const;
+	};
+}
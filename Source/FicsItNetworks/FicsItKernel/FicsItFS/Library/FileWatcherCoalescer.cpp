@@ -0,0 +1,67 @@
+#include "FileWatcherCoalescer.h"
+
+namespace fs = std::filesystem;
+
+namespace FileSystem {
+	FileWatcherCoalescer::FileWatcherCoalescer(const fs::path& realPath) : realPath(realPath) {}
+
+	void FileWatcherCoalescer::push(int eventType, NodeType type, Path path, Path from) {
+		if (overflow) return;
+		if (eventType == 4) {
+			overflow = true;
+			pending.clear();
+			pendingIndex.clear();
+			return;
+		}
+		if (eventType == 3) {
+			// renames are kept in order, events after the rename get their own entries
+			pendingIndex.erase(path.str());
+			pendingIndex.erase(from.str());
+			pending.push_back({eventType, type, path, from});
+			return;
+		}
+
+		auto index = pendingIndex.find(path.str());
+		if (index == pendingIndex.end()) {
+			pendingIndex[path.str()] = pending.size();
+			pending.push_back({eventType, type, path, Path()});
+			return;
+		}
+
+		PendingEvent& event = pending[index->second];
+		if (type != NT_Else) event.type = type;
+		switch (event.eventType) {
+		case 0:
+			// added & removed again results in no event, further changes are part of the add
+			if (eventType == 1) event.eventType = -1;
+			break;
+		case 1:
+			// removed & added again is a change of the node
+			if (eventType != 1) event.eventType = 2;
+			break;
+		case 2:
+			if (eventType == 1) event.eventType = 1;
+			break;
+		default:
+			event.eventType = eventType;
+		}
+	}
+
+	void FileWatcherCoalescer::flush(const std::function<void(int, NodeType, Path, Path)>& eventFunc) {
+		if (overflow) {
+			overflow = false;
+			eventFunc(2, NT_Directory, Path(), Path());
+			return;
+		}
+		std::vector<PendingEvent> events;
+		std::swap(events, pending);
+		pendingIndex.clear();
+		for (PendingEvent& event : events) {
+			if (event.eventType < 0) continue;
+			if (event.type == NT_Else) {
+				event.type = (event.eventType != 1 && fs::is_directory(realPath / event.path)) ? NT_Directory : NT_File;
+			}
+			eventFunc(event.eventType, event.type, event.path, event.from);
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "FileSystem.h"
+#include "Listener.h"
+
+namespace FileSystem {
+	/*
+	* Collects the raw events of a file watcher and merges multiple events on the same path,
+	* so a burst of changes (f.e. an external editor saving a file) results in just one event per path.
+	* Events use the same types as the file watchers:
+	* 0 = added, 1 = removed, 2 = changed, 3 = renamed, 4 = overflow (the watcher lost events)
+	* If the watcher overflowed, all pending events get dropped and a single change of the device root gets emitted.
+	*/
+	class FileWatcherCoalescer {
+	private:
+		struct PendingEvent {
+			int eventType;
+			NodeType type;
+			Path path;
+			Path from;
+		};
+
+		std::filesystem::path realPath;
+		std::vector<PendingEvent> pending;
+		std::unordered_map<std::string, size_t> pendingIndex;
+		bool overflow = false;
+
+	public:
+		FileWatcherCoalescer(const std::filesystem::path& realPath);
+
+		/*
+		* adds the given raw event to the pending events
+		* if the node type is NT_Else, the type gets resolved when the event gets emitted
+		*/
+		void push(int eventType, NodeType type, Path path, Path from);
+
+		/*
+		* emits all pending events to the given function and clears them
+		*/
+		void flush(const std::function<void(int, NodeType, Path, Path)>& eventFunc);
+	};
+}
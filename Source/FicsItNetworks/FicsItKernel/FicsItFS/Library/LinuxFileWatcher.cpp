@@ -0,0 +1,127 @@
+#include "LinuxFileWatcher.h"
+
+#if PLATFORM_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <unordered_map>
+
+#include "Path.h"
+#include "Listener.h"
+
+namespace fs = std::filesystem;
+
+namespace FileSystem {
+	static const uint32_t WatchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_MOVED_FROM | IN_MOVED_TO;
+
+	struct LinuxDeviceWatcher {
+		int fd = -1;
+		std::unordered_map<int, Path> watches;
+		std::unordered_map<uint32_t, std::pair<Path, NodeType>> moves;
+		alignas(inotify_event) char buffer[64 * 1024];
+	};
+
+	static void AddWatches(LinuxDeviceWatcher* watcherInfo, const fs::path& realPath, const Path& path, const std::function<void(int, NodeType, Path, Path)>* addedFunc) {
+		int wd = inotify_add_watch(watcherInfo->fd, (realPath / path).c_str(), WatchMask);
+		if (wd < 0) return;
+		watcherInfo->watches[wd] = path;
+		try {
+			for (auto& entry : fs::directory_iterator(realPath / path)) {
+				Path child = path / Path(entry.path().filename());
+				bool isDir = fs::is_directory(entry.status());
+				// nodes created in a new directory before the watch got added would be missed otherwise
+				if (addedFunc) (*addedFunc)(0, isDir ? NT_Directory : NT_File, child, Path());
+				if (isDir) AddWatches(watcherInfo, realPath, child, addedFunc);
+			}
+		} catch (...) {}
+	}
+
+	static void ResetWatches(LinuxDeviceWatcher* watcherInfo, const fs::path& realPath) {
+		for (auto& watch : watcherInfo->watches) inotify_rm_watch(watcherInfo->fd, watch.first);
+		watcherInfo->watches.clear();
+		watcherInfo->moves.clear();
+		AddWatches(watcherInfo, realPath, Path(), nullptr);
+	}
+
+	LinuxFileWatcher::LinuxFileWatcher(const std::filesystem::path& path, std::function<void(int, NodeType, Path, Path)> event) : eventFunc(event), realPath(path) {
+		watcherInfo = new LinuxDeviceWatcher();
+		watcherInfo->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (watcherInfo->fd >= 0) AddWatches(watcherInfo, realPath, Path(), nullptr);
+	}
+
+	LinuxFileWatcher::~LinuxFileWatcher() {
+		if (watcherInfo->fd >= 0) close(watcherInfo->fd);
+		delete watcherInfo;
+	}
+
+	void LinuxFileWatcher::tick() {
+		if (watcherInfo->fd < 0) return;
+
+		bool overflow = false;
+		ssize_t length;
+		while ((length = read(watcherInfo->fd, watcherInfo->buffer, sizeof(watcherInfo->buffer))) > 0) {
+			for (char* ptr = watcherInfo->buffer; ptr < watcherInfo->buffer + length; ptr += sizeof(inotify_event) + reinterpret_cast<inotify_event*>(ptr)->len) {
+				const inotify_event* event = reinterpret_cast<inotify_event*>(ptr);
+				if (event->mask & IN_Q_OVERFLOW) {
+					overflow = true;
+					continue;
+				}
+				if (event->mask & IN_IGNORED) {
+					watcherInfo->watches.erase(event->wd);
+					continue;
+				}
+				auto watch = watcherInfo->watches.find(event->wd);
+				if (watch == watcherInfo->watches.end()) continue;
+				Path path = watch->second;
+				if (event->len > 0) path = path / Path(std::string(event->name));
+				NodeType type = (event->mask & IN_ISDIR) ? NT_Directory : NT_File;
+
+				if (event->mask & IN_CREATE) {
+					eventFunc(0, type, path, Path());
+					if (type == NT_Directory) AddWatches(watcherInfo, realPath, path, &eventFunc);
+				} else if (event->mask & IN_DELETE) {
+					eventFunc(1, type, path, Path());
+				} else if (event->mask & IN_MODIFY) {
+					eventFunc(2, type, path, Path());
+				} else if (event->mask & IN_MOVED_FROM) {
+					watcherInfo->moves[event->cookie] = {path, type};
+				} else if (event->mask & IN_MOVED_TO) {
+					auto from = watcherInfo->moves.find(event->cookie);
+					if (from != watcherInfo->moves.end()) {
+						eventFunc(3, type, path, from->second.first);
+						if (type == NT_Directory) {
+							// watch descriptors stay valid on rename, so only the paths need to be updated
+							size_t count = from->second.first.getNodeCount();
+							for (auto& w : watcherInfo->watches) {
+								if (w.second.startsWith(from->second.first)) w.second = path / w.second.removeFrontNodes(count);
+							}
+						}
+						watcherInfo->moves.erase(from);
+					} else {
+						// moved into the watched tree from somewhere else
+						eventFunc(0, type, path, Path());
+						if (type == NT_Directory) AddWatches(watcherInfo, realPath, path, &eventFunc);
+					}
+				}
+			}
+		}
+
+		// nodes moved out of the watched tree
+		for (auto& move : watcherInfo->moves) {
+			eventFunc(1, move.second.second, move.second.first, Path());
+			if (move.second.second != NT_Directory) continue;
+			for (auto w = watcherInfo->watches.begin(); w != watcherInfo->watches.end();) {
+				if (w->second.startsWith(move.second.first)) {
+					inotify_rm_watch(watcherInfo->fd, w->first);
+					w = watcherInfo->watches.erase(w);
+				} else ++w;
+			}
+		}
+		watcherInfo->moves.clear();
+
+		if (overflow) {
+			eventFunc(4, NT_Else, Path(), Path());
+			ResetWatches(watcherInfo, realPath);
+		}
+	}
+}
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <functional>
+
+#include "FileSystem.h"
+#include "Listener.h"
+
+namespace FileSystem {
+	struct LinuxDeviceWatcher;
+
+	/*
+	* File watcher for linux (f.e. dedicated servers) using inotify.
+	* Because inotify is not recursive, a watch gets added for every directory in the tree.
+	*/
+	class LinuxFileWatcher {
+	public:
+		LinuxDeviceWatcher* watcherInfo = nullptr;
+		std::function<void(int, NodeType, Path, Path)> eventFunc;
+		std::filesystem::path realPath;
+
+		LinuxFileWatcher(const std::filesystem::path& path, std::function<void(int, NodeType, Path, Path)> eventFunc);
+		~LinuxFileWatcher();
+		void tick();
+	};
+}
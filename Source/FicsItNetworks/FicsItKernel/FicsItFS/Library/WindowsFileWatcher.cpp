@@ -1,5 +1,6 @@
 #include "WindowsFileWatcher.h"
 
+#if PLATFORM_WINDOWS
 #include "Engine.h"
 #define WIN32_LEAN_AND_MEAN
 #include "Windows.h"
@@ -15,9 +16,13 @@ namespace FileSystem {
 	struct DiskDeviceWatcher {
 		HANDLE watcher;
 		OVERLAPPED ovl;
-		FILE_NOTIFY_INFORMATION info[16];
+		DWORD info[16 * 1024];
 	};
 
+	static void ReadChanges(DiskDeviceWatcher* watcherInfo) {
+		ReadDirectoryChangesW(watcherInfo->watcher, &watcherInfo->info, sizeof(watcherInfo->info), true, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, &watcherInfo->ovl, NULL);
+	}
+
 	WindowsFileWatcher::WindowsFileWatcher(const std::filesystem::path& path, std::function<void(int, NodeType, Path, Path)> event) : eventFunc(event), realPath(path) {
 		watcherInfo = new DiskDeviceWatcher();
 		watcherInfo->watcher = ::CreateFile(path.wstring().c_str(),
@@ -28,10 +33,13 @@ namespace FileSystem {
 		watcherInfo->ovl = {0};
 		watcherInfo->ovl.hEvent = CreateEvent(NULL, true, false, NULL);
 		memset(&watcherInfo->info, 0, sizeof(watcherInfo->info));
-		ReadDirectoryChangesW(watcherInfo->watcher, &watcherInfo->info, sizeof(watcherInfo->info), true, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, &watcherInfo->ovl, NULL);
+		ReadChanges(watcherInfo);
 	}
 
 	WindowsFileWatcher::~WindowsFileWatcher() {
+		CancelIo(watcherInfo->watcher);
+		CloseHandle(watcherInfo->ovl.hEvent);
+		CloseHandle(watcherInfo->watcher);
 		delete watcherInfo;
 	}
 
@@ -39,36 +47,42 @@ namespace FileSystem {
 		DWORD status = WaitForSingleObject(watcherInfo->ovl.hEvent, 0);
 		if (status != WAIT_OBJECT_0) return;
 
-		FILE_NOTIFY_INFORMATION* current = &watcherInfo->info[0];
-		std::wstring bufStr;
-		while (current) {
-			std::wstring fname = std::wstring((const wchar_t*)&current->FileName, current->FileNameLength);
-			std::replace(fname.begin(), fname.end(), L'\\', L'/');
-			Path path = fs::path(fname);
-			bool isDir = fs::is_directory(realPath / path);
-			NodeType type = (isDir) ? NT_Directory : NT_File;
-			switch (current->Action) {
-			case FILE_ACTION_ADDED:
-				eventFunc(0, type, path, Path());
-				break;
-			case FILE_ACTION_REMOVED:
-				eventFunc(1, type, path, Path());
-				break;
-			case FILE_ACTION_MODIFIED:
-				eventFunc(2, type, path, Path());
-				break;
-			case FILE_ACTION_RENAMED_NEW_NAME:
-				eventFunc(3, type, path, fs::path(bufStr));
-				break;
-			case FILE_ACTION_RENAMED_OLD_NAME:
-				bufStr = fname;
-				break;
+		DWORD bytes = 0;
+		if (!GetOverlappedResult(watcherInfo->watcher, &watcherInfo->ovl, &bytes, false) || bytes == 0) {
+			// the buffer overflowed & the events got lost
+			eventFunc(4, NT_Else, Path(), Path());
+		} else {
+			FILE_NOTIFY_INFORMATION* current = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(&watcherInfo->info[0]);
+			std::wstring bufStr;
+			while (current) {
+				std::wstring fname = std::wstring((const wchar_t*)&current->FileName, current->FileNameLength / sizeof(WCHAR));
+				std::replace(fname.begin(), fname.end(), L'\\', L'/');
+				Path path = fs::path(fname);
+				// node type gets resolved by the coalescer once per path
+				switch (current->Action) {
+				case FILE_ACTION_ADDED:
+					eventFunc(0, NT_Else, path, Path());
+					break;
+				case FILE_ACTION_REMOVED:
+					eventFunc(1, NT_Else, path, Path());
+					break;
+				case FILE_ACTION_MODIFIED:
+					eventFunc(2, NT_Else, path, Path());
+					break;
+				case FILE_ACTION_RENAMED_NEW_NAME:
+					eventFunc(3, fs::is_directory(realPath / path) ? NT_Directory : NT_File, path, fs::path(bufStr));
+					break;
+				case FILE_ACTION_RENAMED_OLD_NAME:
+					bufStr = fname;
+					break;
+				}
+				if (current->NextEntryOffset <= 0) break;
+				current = (FILE_NOTIFY_INFORMATION*)((size_t)current + current->NextEntryOffset);
 			}
-			if (current->NextEntryOffset <= 0) break;
-			auto old = current;
-			current = (FILE_NOTIFY_INFORMATION*)((size_t)current + current->NextEntryOffset);
 		}
+		ResetEvent(watcherInfo->ovl.hEvent);
 		memset(&watcherInfo->info, 0, sizeof(watcherInfo->info));
-		ReadDirectoryChangesW(watcherInfo->watcher, &watcherInfo->info, sizeof(watcherInfo->info), true, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, &watcherInfo->ovl, NULL);
+		ReadChanges(watcherInfo);
 	}
 }
+#endif
@@ -25,6 +25,7 @@ namespace FicsItKernel {
 		if (getState() == RESET) if (!start(true)) return;
 		if (getState() == RUNNING) {
 			if (devDevice) devDevice->tickListeners();
+			filesystem.tickTransfers(fileTransferBudget);
 			if (processor) processor->tick(deltaSeconds);
 			else crash(FicsItKernel::KernelCrash("Processor Unplugged"));
 		}
@@ -273,6 +274,9 @@ namespace FicsItKernel {
 
 		// pre serialize network
 		network->PreSerialize(bLoading);
+
+		// pre serialize filesystem
+		filesystem.PreSerialize(bLoading);
 		
 		// pre serialize processor
 		if (processor.get() != nullptr) {
@@ -67,6 +67,7 @@ namespace FicsItKernel {
 		TSet<FWeakObjectPtr> screens;
 		std::queue<TSharedPtr<TFINDynamicStruct<FFINFuture>>> futureQueue;
 		std::chrono::time_point<std::chrono::high_resolution_clock> systemResetTimePoint;
+		std::size_t fileTransferBudget = 4 * 1024 * 1024;
 		
 	public:
 		/**
@@ -6,6 +6,8 @@
 #include "Network/FINDynamicStructHolder.h"
 #include "Network/FINNetworkCircuitNode.h"
 #include "Network/FINNetworkUtils.h"
+#include "Computer/FINComputerModule.h"
+#include "Computer/FINComputerSubsystem.h"
 
 namespace FicsItKernel {
 	namespace Network {
@@ -13,30 +15,124 @@ namespace FicsItKernel {
 			pushSignal(signal, sender);
 		}
 
-		FFINSignalData NetworkController::popSignal(FFINNetworkTrace& sender) {
-			if (getSignalCount() < 1) return FFINSignalData();
-			mutexSignals.lock();
-			auto sig = signals.front();
-			signals.pop_front();
-			mutexSignals.unlock();
-			sender = sig.Value;
-			return sig.Key;
+		FFINSignalData NetworkController::popSignal(FFINNetworkTrace& sender, int32* coalesceCount) {
+			std::lock_guard<std::mutex> m(mutexSignals);
+			for (auto& queue : signals) {
+				if (queue.empty()) continue;
+				removePendingCoalesced(queue.front());
+				PendingSignal sig = queue.front();
+				queue.pop_front();
+				sender = sig.Sender;
+				if (coalesceCount) *coalesceCount = sig.CoalesceCount;
+				return sig.Signal;
+			}
+			return FFINSignalData();
 		}
 
 		void NetworkController::pushSignal(const FFINSignalData& signal, const FFINNetworkTrace& sender) {
 			std::lock_guard<std::mutex> m(mutexSignals);
-			if (signals.size() >= maxSignalCount || lockSignalRecieving) return;
-			signals.push_back(TPair<FFINSignalData, FFINNetworkTrace>{signal, sender});
+			if (lockSignalRecieving) return;
+			bool bCoalesce = shouldCoalesce(signal, sender);
+			if (bCoalesce) {
+				PendingSignal** pending = pendingCoalescedSignals.Find(TPair<FFINNetworkTrace, UFINSignal*>(sender, signal.Signal));
+				if (pending) {
+					(*pending)->Signal = signal;
+					++(*pending)->CoalesceCount;
+					return;
+				}
+			}
+			SignalPriority priority = getSenderPriority(sender);
+			auto& queue = signals[priority];
+			if (queue.size() >= maxSignalCount[priority]) {
+				++droppedSignals[priority];
+				return;
+			}
+			queue.push_back(PendingSignal{signal, sender, bCoalesce ? 1 : 0});
+			if (bCoalesce) pendingCoalescedSignals.Add(TPair<FFINNetworkTrace, UFINSignal*>(sender, signal.Signal), &queue.back());
 		}
 
 		void NetworkController::clearSignals() {
 			std::lock_guard<std::mutex> m(mutexSignals);
-			signals.clear();
+			for (auto& queue : signals) queue.clear();
+			pendingCoalescedSignals.Empty();
 		}
 
 		size_t NetworkController::getSignalCount() {
 			std::lock_guard<std::mutex> m(mutexSignals);
-			return signals.size();
+			size_t count = 0;
+			for (const auto& queue : signals) count += queue.size();
+			return count;
+		}
+
+		SignalPriority NetworkController::getSenderPriority(const FFINNetworkTrace& sender) const {
+			const SignalPriority* priority = senderPriorities.Find(sender);
+			if (priority) return *priority;
+			UObject* obj = sender.GetUnderlyingPtr().Get();
+			if (obj && obj->IsA<AFINComputerModule>()) return SIGNAL_PRIORITY_HIGH;
+			return SIGNAL_PRIORITY_NORMAL;
+		}
+
+		bool NetworkController::shouldCoalesce(const FFINSignalData& signal, const FFINNetworkTrace& sender) const {
+			if (!signal.Signal || coalescedSignals.Num() < 1) return false;
+			const TSet<FString>* senderSignals = coalescedSignals.Find(sender);
+			return senderSignals && senderSignals->Contains(signal.Signal->GetInternalName());
+		}
+
+		void NetworkController::removePendingCoalesced(const PendingSignal& signal) {
+			if (signal.CoalesceCount < 1) return;
+			TPair<FFINNetworkTrace, UFINSignal*> key(signal.Sender, signal.Signal.Signal);
+			PendingSignal** pending = pendingCoalescedSignals.Find(key);
+			if (pending && *pending == &signal) pendingCoalescedSignals.Remove(key);
+		}
+
+		void NetworkController::setSenderPriority(const FFINNetworkTrace& sender, SignalPriority priority) {
+			std::lock_guard<std::mutex> m(mutexSignals);
+			senderPriorities.Add(sender, priority);
+		}
+
+		void NetworkController::resetSenderPriority(const FFINNetworkTrace& sender) {
+			std::lock_guard<std::mutex> m(mutexSignals);
+			senderPriorities.Remove(sender);
+		}
+
+		void NetworkController::resetSenderPriorities() {
+			std::lock_guard<std::mutex> m(mutexSignals);
+			senderPriorities.Empty();
+		}
+
+		void NetworkController::setSignalCoalescing(const FFINNetworkTrace& sender, const FString& signal, bool enable) {
+			std::lock_guard<std::mutex> m(mutexSignals);
+			if (enable) {
+				coalescedSignals.FindOrAdd(sender).Add(signal);
+				return;
+			}
+			TSet<FString>* senderSignals = coalescedSignals.Find(sender);
+			if (senderSignals) {
+				senderSignals->Remove(signal);
+				if (senderSignals->Num() < 1) coalescedSignals.Remove(sender);
+			}
+			for (auto pending = pendingCoalescedSignals.CreateIterator(); pending; ++pending) {
+				if (pending.Key().Key == sender && pending.Key().Value && pending.Key().Value->GetInternalName() == signal) pending.RemoveCurrent();
+			}
+		}
+
+		void NetworkController::resetSignalCoalescing(const FFINNetworkTrace& sender) {
+			std::lock_guard<std::mutex> m(mutexSignals);
+			coalescedSignals.Remove(sender);
+			for (auto pending = pendingCoalescedSignals.CreateIterator(); pending; ++pending) {
+				if (pending.Key().Key == sender) pending.RemoveCurrent();
+			}
+		}
+
+		void NetworkController::resetSignalCoalescing() {
+			std::lock_guard<std::mutex> m(mutexSignals);
+			coalescedSignals.Empty();
+			pendingCoalescedSignals.Empty();
+		}
+
+		uint64 NetworkController::getDroppedSignalCount(SignalPriority priority) {
+			std::lock_guard<std::mutex> m(mutexSignals);
+			return droppedSignals[priority];
 		}
 
 		FFINNetworkTrace NetworkController::getComponentByID(const FString& id) {
@@ -65,12 +161,13 @@ namespace FicsItKernel {
 			if (component->Implements<UFINNetworkComponent>()) {
 				TSet<FFINNetworkTrace> outComps;
 				TSet<UObject*> Comps = IFINNetworkCircuitNode::Execute_GetCircuit(component)->GetComponents();
+				FGuid ID = UFINNetworkUtils::GetNetworkComponentID(component);
 				for (UObject* Comp : Comps) {
 					if (bRedirect) {
 						UObject* RedirectedComp = UFINNetworkUtils::RedirectIfPossible(FFINNetworkTrace(Comp)).Get();
 						if (!RedirectedComp->IsA(Class)) continue;
 					} else if (!Comp->IsA(Class)) continue;
-					if (!IFINNetworkComponent::Execute_AccessPermitted(Comp, IFINNetworkComponent::Execute_GetID(component))) continue;
+					if (!IFINNetworkComponent::Execute_AccessPermitted(Comp, ID)) continue;
 					outComps.Add(FFINNetworkTrace(component) / Comp);
 				}
 				return outComps;
@@ -94,18 +191,23 @@ namespace FicsItKernel {
 			}
 
 			// serialize signals
-			int32 signalCount = signals.size();
+			std::deque<PendingSignal> allSignals;
+			if (Ar.IsSaving()) for (const auto& queue : signals) {
+				for (const PendingSignal& sig : queue) if (sig.Sender.IsValid()) allSignals.push_back(sig);
+			}
+			int32 signalCount = allSignals.size();
 			Ar << signalCount;
 			if (Ar.IsLoading()) {
-				signals.clear();
+				for (auto& queue : signals) queue.clear();
+				pendingCoalescedSignals.Empty();
 			}
 			for (int i = 0; i < signalCount; ++i) {
 				FFINSignalData Signal;
 				FFINNetworkTrace Trace;
 				if (Ar.IsSaving()) {
-					const auto& sig = signals[i];
-					Signal = sig.Key;
-					Trace = sig.Value;
+					const auto& sig = allSignals[i];
+					Signal = sig.Signal;
+					Trace = sig.Sender;
 				}
 				bool valid = Trace.IsValid();
 				Ar << valid;
@@ -116,12 +218,70 @@ namespace FicsItKernel {
 				Trace.Serialize(Ar);
 				
 				if (Ar.IsLoading()) {
-					signals.push_back(TPair<FFINSignalData, FFINNetworkTrace>{Signal, Trace});
+					allSignals.push_back(PendingSignal{Signal, Trace});
 				}
 			}
 
 			// serialize signal senders
 			Ar << signalSenders;
+
+			AFINComputerSubsystem* subsystem = AFINComputerSubsystem::GetComputerSubsystem(component);
+			
+			// serialize sender priorities
+			if (subsystem && subsystem->Version >= EFINCustomVersion::FINSignalPriorities) {
+				int32 priorityCount = senderPriorities.Num();
+				Ar << priorityCount;
+				if (Ar.IsLoading()) senderPriorities.Empty();
+				auto priorityIter = senderPriorities.CreateIterator();
+				for (int i = 0; i < priorityCount; ++i) {
+					FFINNetworkTrace Trace;
+					uint8 Priority = 0;
+					if (Ar.IsSaving()) {
+						Trace = priorityIter.Key();
+						Priority = priorityIter.Value();
+						++priorityIter;
+					}
+					Trace.Serialize(Ar);
+					Ar << Priority;
+					if (Ar.IsLoading() && Priority < SIGNAL_PRIORITY_COUNT) {
+						senderPriorities.Add(Trace, (SignalPriority)Priority);
+					}
+				}
+			}
+
+			// serialize coalesced signals and the coalesce counts of the pending signals
+			if (subsystem && subsystem->Version >= EFINCustomVersion::FINSignalCoalescing) {
+				int32 coalescedCount = coalescedSignals.Num();
+				Ar << coalescedCount;
+				if (Ar.IsLoading()) coalescedSignals.Empty();
+				auto coalescedIter = coalescedSignals.CreateIterator();
+				for (int i = 0; i < coalescedCount; ++i) {
+					FFINNetworkTrace Trace;
+					TArray<FString> SignalNames;
+					if (Ar.IsSaving()) {
+						Trace = coalescedIter.Key();
+						SignalNames = coalescedIter.Value().Array();
+						++coalescedIter;
+					}
+					Trace.Serialize(Ar);
+					Ar << SignalNames;
+					if (Ar.IsLoading()) coalescedSignals.Add(Trace, TSet<FString>(SignalNames));
+				}
+
+				TArray<int32> coalesceCounts;
+				if (Ar.IsSaving()) for (const PendingSignal& sig : allSignals) coalesceCounts.Add(sig.CoalesceCount);
+				Ar << coalesceCounts;
+				if (Ar.IsLoading()) for (int i = 0; i < coalesceCounts.Num() && i < allSignals.size(); ++i) {
+					allSignals[i].CoalesceCount = coalesceCounts[i];
+				}
+			}
+
+			// queue the signals by the priority of their sender, needs the sender priorities to be loaded
+			if (Ar.IsLoading()) for (const PendingSignal& sig : allSignals) {
+				auto& queue = signals[getSenderPriority(sig.Sender)];
+				queue.push_back(sig);
+				if (sig.CoalesceCount > 0) pendingCoalescedSignals.Add(TPair<FFINNetworkTrace, UFINSignal*>(sig.Sender, sig.Signal.Signal), &queue.back());
+			}
 		}
 
 		void NetworkController::PostSerialize(bool load) {
@@ -11,6 +11,32 @@
 
 namespace FicsItKernel {
 	namespace Network {
+		/**
+		 * The priority classes of signals.
+		 * Every class has its own queue and quota, so a flood of signals of one class
+		 * is not able to push the signals of another class out of the queue.
+		 */
+		enum SignalPriority {
+			SIGNAL_PRIORITY_HIGH,
+			SIGNAL_PRIORITY_NORMAL,
+			SIGNAL_PRIORITY_LOW,
+			SIGNAL_PRIORITY_COUNT
+		};
+		
+		/**
+		 * A signal waiting in the signal queue.
+		 */
+		struct PendingSignal {
+			FFINSignalData Signal;
+			FFINNetworkTrace Sender;
+
+			/**
+			 * The amount of signals which got coalesced into this one.
+			 * Zero if the signal is not coalesced.
+			 */
+			int32 CoalesceCount = 0;
+		};
+
 		/**
 		 * Allows to control and manage network connection of a system.
 		 * Also manages the network signals.
@@ -20,9 +46,31 @@ namespace FicsItKernel {
 			std::mutex mutexSignalListeners;
 			TSet<FFINNetworkTrace> signalListeners;
 			std::mutex mutexSignals;
-			std::deque<TPair<FFINSignalData, FFINNetworkTrace>> signals;
+			std::deque<PendingSignal> signals[SIGNAL_PRIORITY_COUNT];
+			uint64 droppedSignals[SIGNAL_PRIORITY_COUNT] = {0};
+			TMap<FFINNetworkTrace, SignalPriority> senderPriorities;
+			TMap<FFINNetworkTrace, TSet<FString>> coalescedSignals;
+			TMap<TPair<FFINNetworkTrace, UFINSignal*>, PendingSignal*> pendingCoalescedSignals;
 			bool lockSignalRecieving = false;
 
+			/**
+			 * returns the priority class signals of the given sender get queued in.
+			 * Needs the signal mutex to be locked.
+			 */
+			SignalPriority getSenderPriority(const FFINNetworkTrace& sender) const;
+
+			/**
+			 * checks if the given signal of the given sender should get coalesced.
+			 * Needs the signal mutex to be locked.
+			 */
+			bool shouldCoalesce(const FFINSignalData& signal, const FFINNetworkTrace& sender) const;
+
+			/**
+			 * removes the given signal from the pending coalesced signals if it is one.
+			 * Needs the signal mutex to be locked.
+			 */
+			void removePendingCoalesced(const PendingSignal& signal);
+
 		public:
 			virtual ~NetworkController() {}
 
@@ -39,24 +87,28 @@ namespace FicsItKernel {
 			UObject* component = nullptr;
 
 			/**
-			 * The maximum amount of signals the signal queue can hold
+			 * The maximum amount of signals the signal queue of each priority class can hold
 			 */
-			uint32 maxSignalCount = 1000;
+			uint32 maxSignalCount[SIGNAL_PRIORITY_COUNT] = {1000, 1000, 1000};
 
 			void handleSignal(const FFINSignalData& signal, const FFINNetworkTrace& sender);
 
 			/**
 			 * pops a signal form the queue.
+			 * signals of higher priority classes get popped first.
 			 * returns nullptr if there is no signal left.
 			 *
 			 * @param sender - out put paramter for the sender of the signal
+			 * @param coalesceCount - optional out put parameter for the amount of signals coalesced into the signal, zero if not coalesced
 			 * @return	singal from the queue
 			 */
-			FFINSignalData popSignal(FFINNetworkTrace& sender);
+			FFINSignalData popSignal(FFINNetworkTrace& sender, int32* coalesceCount = nullptr);
 
 			/**
-			 * pushes a signal to the queue.
-			 * signal gets dropped if the queue is already full.
+			 * pushes a signal to the queue of the priority class of the sender.
+			 * signal gets dropped if the queue of that class is already full.
+			 * if the signal should get coalesced and the same signal of the same sender is still pending,
+			 * the pending signal gets the data of the new signal and its coalesce count gets increased instead.
 			 *
 			 * @param	signal	the singal you want to push
 			 */
@@ -74,6 +126,60 @@ namespace FicsItKernel {
 			 */
 			size_t getSignalCount();
 
+			/**
+			 * sets the priority class signals of the given sender get queued in.
+			 * Senders without explicitly set priority use high priority if they are a computer module
+			 * and normal priority otherwise.
+			 *
+			 * @param[in]	sender		the signal sender
+			 * @param[in]	priority	the priority class of the senders signals
+			 */
+			void setSenderPriority(const FFINNetworkTrace& sender, SignalPriority priority);
+
+			/**
+			 * removes the explicitly set priority of the given sender
+			 *
+			 * @param[in]	sender	the signal sender
+			 */
+			void resetSenderPriority(const FFINNetworkTrace& sender);
+
+			/**
+			 * removes all explicitly set sender priorities
+			 */
+			void resetSenderPriorities();
+
+			/**
+			 * enables or disables coalescing of the given signal of the given sender.
+			 * While a coalesced signal is pending, further signals of the same type and sender
+			 * only update the data of the pending signal and increase its coalesce count.
+			 *
+			 * @param[in]	sender	the signal sender
+			 * @param[in]	signal	the internal name of the signal
+			 * @param[in]	enable	true if the signal should get coalesced
+			 */
+			void setSignalCoalescing(const FFINNetworkTrace& sender, const FString& signal, bool enable);
+
+			/**
+			 * disables coalescing of all signals of the given sender
+			 *
+			 * @param[in]	sender	the signal sender
+			 */
+			void resetSignalCoalescing(const FFINNetworkTrace& sender);
+
+			/**
+			 * disables coalescing of all signals of all senders
+			 */
+			void resetSignalCoalescing();
+
+			/**
+			 * gets the amount of signals of the given priority class which got dropped
+			 * because the queue of the class was full
+			 *
+			 * @param[in]	priority	the priority class
+			 * @return	amount of dropped signals
+			 */
+			uint64 getDroppedSignalCount(SignalPriority priority);
+
 			/**
 			 * trys to find a component with the given ID.
 			 *
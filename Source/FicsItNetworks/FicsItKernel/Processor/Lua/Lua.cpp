@@ -6,6 +6,7 @@
 #include "LuaProcessor.h"
 #include "LuaStructs.h"
 #include "Network/FINNetworkComponent.h"
+#include "Network/FINNetworkUtils.h"
 #include "Reflection/FINArrayProperty.h"
 #include "Reflection/FINClassProperty.h"
 #include "Reflection/FINObjectProperty.h"
@@ -34,7 +35,7 @@ namespace FicsItKernel {
 				} else {
 					UObject* Obj = *p->ContainerPtrToValuePtr<UObject*>(data);
 					trace = trace / Obj;
-					if (Obj && Obj->Implements<UFINNetworkComponent>()) trace = trace / IFINNetworkComponent::Execute_GetInstanceRedirect(Obj);
+					if (Obj && Obj->Implements<UFINNetworkComponent>()) trace = trace / UFINNetworkUtils::GetInstanceRedirect(Obj);
 					newInstance(L, trace);
 				}
 			} else if (c & EClassCastFlags::CASTCLASS_UStructProperty) {
@@ -12,9 +12,12 @@
 #include "Network/FINHookSubsystem.h"
 #include "Network/FINNetworkTrace.h"
 #include "Network/Signals/FINSignalSubsystem.h"
+#include "Reflection/FINReflection.h"
 
 namespace FicsItKernel {
 	namespace Lua {
+		static const char* const luaSignalPriorities[] = {"high", "normal", "low", nullptr};
+
 		void luaListen(lua_State* L, FFINNetworkTrace o) {
 			auto net = LuaProcessor::luaGetProcessor(L)->getKernel()->getNetwork();
 			UObject* obj = *o;
@@ -27,10 +30,19 @@ namespace FicsItKernel {
 			FLuaSyncCall SyncCall(L);
 			int args = lua_gettop(L);
 
+			// optional trailing priority class for the signals of all given components
+			int priority = -1;
+			if (args > 0 && lua_type(L, args) == LUA_TSTRING) {
+				priority = luaL_checkoption(L, args, nullptr, luaSignalPriorities);
+				--args;
+			}
+
+			auto net = LuaProcessor::luaGetProcessor(L)->getKernel()->getNetwork();
 			for (int i = 1; i <= args; ++i) {
 				FFINNetworkTrace trace;
 				auto o = (UObject*)getObjInstance<UObject>(L, i, &trace);
 				luaListen(L, trace / o);
+				if (priority >= 0) net->setSenderPriority(trace / o, (Network::SignalPriority)priority);
 			}
 			return LuaProcessor::luaAPIReturn(L, 0);
 		}
@@ -84,6 +96,8 @@ namespace FicsItKernel {
 			if (!IsValid(obj)) luaL_error(L, "object is not valid");
 			AFINSignalSubsystem* SigSubSys = AFINSignalSubsystem::GetSignalSubsystem(obj);
 			SigSubSys->Ignore(obj, *o.Reverse());
+			net->resetSenderPriority(o);
+			net->resetSignalCoalescing(o);
 		}
 
 		int luaIgnore(lua_State* L) {
@@ -103,6 +117,8 @@ namespace FicsItKernel {
 			auto net = LuaProcessor::luaGetProcessor(L)->getKernel()->getNetwork();
 			AFINSignalSubsystem* SigSubSys = AFINSignalSubsystem::GetSignalSubsystem(net->component);
 			SigSubSys->IgnoreAll(net->component);
+			net->resetSenderPriorities();
+			net->resetSignalCoalescing();
 			return LuaProcessor::luaAPIReturn(L, 1);
 		}
 
@@ -111,6 +127,27 @@ namespace FicsItKernel {
 			return 0;
 		}
 
+		int luaCoalesce(lua_State* L) {
+			FLuaSyncCall SyncCall(L);
+			FFINNetworkTrace trace;
+			UObject* o = getObjInstance<UObject>(L, 1, &trace);
+			FString signalName = UTF8_TO_TCHAR(luaL_checkstring(L, 2));
+			bool enable = lua_isnoneornil(L, 3) || lua_toboolean(L, 3);
+			if (!IsValid(o)) return luaL_error(L, "object is not valid");
+			UFINClass* Class = FFINReflection::Get()->FindClass(o->GetClass());
+			if (!Class || !Class->FindFINSignal(signalName)) return luaL_error(L, "object has no signal '%s'", TCHAR_TO_UTF8(*signalName));
+			LuaProcessor::luaGetProcessor(L)->getKernel()->getNetwork()->setSignalCoalescing(trace / o, signalName, enable);
+			return LuaProcessor::luaAPIReturn(L, 0);
+		}
+
+		int luaDropped(lua_State* L) {
+			auto net = LuaProcessor::luaGetProcessor(L)->getKernel()->getNetwork();
+			for (int i = 0; i < Network::SIGNAL_PRIORITY_COUNT; ++i) {
+				lua_pushinteger(L, net->getDroppedSignalCount((Network::SignalPriority)i));
+			}
+			return Network::SIGNAL_PRIORITY_COUNT;
+		}
+
 		static const luaL_Reg luaEventLib[] = {
 			{"listen", luaListen},
 			{"listening", luaListening},
@@ -118,6 +155,8 @@ namespace FicsItKernel {
 			{"ignore", luaIgnore},
 			{"ignoreAll", luaIgnoreAll},
 			{"clear", luaClear},
+			{"coalesce", luaCoalesce},
+			{"dropped", luaDropped},
 			{NULL,NULL}
 		};
 
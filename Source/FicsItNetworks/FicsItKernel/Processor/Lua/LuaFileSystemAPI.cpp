@@ -140,6 +140,43 @@ namespace FicsItKernel {
 			return LuaProcessor::luaAPIReturn(L, 1);
 		})
 
+		LuaFunc(copy, {
+			auto from = luaL_checkstring(L, 1);
+			auto to = luaL_checkstring(L, 2);
+			bool recursive = lua_toboolean(L, 3);
+			try {
+				lua_pushboolean(L, self->copy(from, to, recursive) == 0);
+			} CatchExceptionLua
+			return LuaProcessor::luaAPIReturn(L, 1);
+		})
+
+		LuaFunc(transfer, {
+			auto from = luaL_checkstring(L, 1);
+			auto to = luaL_checkstring(L, 2);
+			bool recursive = lua_toboolean(L, 3);
+			bool move = lua_toboolean(L, 4);
+			try {
+				int handle = self->startTransfer(from, to, recursive, move);
+				if (handle) lua_pushinteger(L, handle);
+				else lua_pushnil(L);
+			} CatchExceptionLua
+			return LuaProcessor::luaAPIReturn(L, 1);
+		})
+
+		LuaFunc(transferStatus, {
+			int handle = static_cast<int>(luaL_checkinteger(L, 1));
+			FileSystem::SRef<FileSystem::FileTransfer> transfer = self->getTransfer(handle);
+			if (!transfer.isValid()) {
+				lua_pushnil(L);
+				return LuaProcessor::luaAPIReturn(L, 1);
+			}
+			lua_pushboolean(L, transfer->isDone());
+			lua_pushinteger(L, transfer->getBytesCopied());
+			lua_pushinteger(L, transfer->getBytesTotal());
+			lua_pushboolean(L, !transfer->hasFailed());
+			return LuaProcessor::luaAPIReturn(L, 4);
+		})
+
 		LuaFunc(rename, {
 			auto from = luaL_checkstring(L, 1);
 			auto to = luaL_checkstring(L, 2);
@@ -209,43 +246,63 @@ namespace FicsItKernel {
 			return lua_gettop(L) - 1;
 		}
 
-		LuaFunc(doFile, {
-			FileSystem::Path path = luaL_checkstring(L, 1);
+		static int luaChunkWriter(lua_State* L, const void* p, size_t sz, void* ud) {
+			static_cast<std::string*>(ud)->append(static_cast<const char*>(p), sz);
+			return 0;
+		}
+
+		/**
+		 * Loads the file at the given path as chunk onto the stack.
+		 * Uses the compiled chunk of the filesystem code cache if the file didn't change,
+		 * otherwise compiles the file and stores the compiled chunk in the cache.
+		 */
+		static int luaLoadFileCached(lua_State* L, FicsItFS::Root* self, const FileSystem::Path& path) {
+			size_t size = 0;
+			std::int64_t stamp = 0;
+			bool stamped = self->getFileStamp(path, size, stamp);
+			if (stamped) {
+				const std::string* chunk = self->getCodeCache().find(path, size, stamp);
+				if (chunk) return luaL_loadbufferx(L, chunk->c_str(), chunk->size(), ("@" + path.str()).c_str(), "b");
+			}
+			
 			FileSystem::SRef<FileSystem::FileStream> file;
 			try {
 				file = self->open(path, FileSystem::INPUT);
 			} CatchExceptionLua
 			if (!file.isValid()) return luaL_error(L, "not able to create filestream");
 			std::string code;
+			const char* data = nullptr;
+			size_t length = 0;
 			try {
-				code = file->readAll();
+				data = file->peekAll(length);
+				if (!data) {
+					code = file->readAll();
+					data = code.c_str();
+					length = code.size();
+				}
 			} CatchExceptionLua
+
+			int status = luaL_loadbufferx(L, data, length, ("@" + path.str()).c_str(), "t");
 			try {
 				file->close();
 			} CatchExceptionLua
-			int n = lua_gettop(L) - 1;
-			luaL_loadbufferx(L, code.c_str(), code.size(), ("@" + path.str()).c_str(), "t");
+			if (status == LUA_OK && stamped && size == length) {
+				std::string chunk;
+				if (lua_dump(L, luaChunkWriter, &chunk, 0) == 0) self->getCodeCache().store(path, size, stamp, std::move(chunk));
+			}
+			return status;
+		}
+
+		LuaFunc(doFile, {
+			FileSystem::Path path = luaL_checkstring(L, 1);
+			luaLoadFileCached(L, self, path);
 			lua_callk(L, 0, LUA_MULTRET, 0, luaDoFileCont);
 			return luaDoFileCont(L, 0, 0);
 		})
 
 		LuaFunc(loadFile, {
 			FileSystem::Path path = luaL_checkstring(L, 1);
-			FileSystem::SRef<FileSystem::FileStream> file;
-			try {
-				file = self->open(path, FileSystem::INPUT);
-			} CatchExceptionLua
-			if (!file.isValid()) return luaL_error(L, "not able to create filestream");
-			std::string code;
-			try {
-				code = file->readAll();
-			} CatchExceptionLua
-			try {
-				file->close();
-			} CatchExceptionLua
-			
-			int n = lua_gettop(L) - 1;
-			luaL_loadbufferx(L, code.c_str(), code.size(), ("@" + path.str()).c_str(), "t");
+			luaLoadFileCached(L, self, path);
 			return LuaProcessor::luaAPIReturn(L, 1);
 		})
 
@@ -257,6 +314,9 @@ namespace FicsItKernel {
 			{"createDir", createDir},
 			{"remove", remove},
 			{"move", move},
+			{"copy", copy},
+			{"transfer", transfer},
+			{"transferStatus", transferStatus},
 			{"rename", rename},
 			{"exists", exists},
 			{"childs", childs},
@@ -269,6 +329,20 @@ namespace FicsItKernel {
 			{NULL,NULL}
 		};
 
+		/**
+		 * Reads the next line of the given file stream and pushes it onto the stack,
+		 * directly from the streams buffer if possible.
+		 */
+		static void luaPushLine(lua_State* L, FileSystem::SRef<FileSystem::FileStream>& file) {
+			size_t length = 0;
+			if (const char* data = file->readLineBuffered(length)) {
+				lua_pushlstring(L, data, length);
+			} else {
+				std::string text = file->readLine();
+				lua_pushlstring(L, text.c_str(), text.length());
+			}
+		}
+
 		LuaFileFunc(Close, {
 			try {
 				file->close();
@@ -282,7 +356,7 @@ namespace FicsItKernel {
 				size_t str_len = 0;
 				const char* str = luaL_checklstring(L, i, &str_len);
 				try {
-					file->write(std::string(str, str_len));
+					file->write(str, str_len);
 				} CatchExceptionLua
 			}
 			return LuaProcessor::luaAPIReturn(L, 0);
@@ -303,8 +377,13 @@ namespace FicsItKernel {
 					if (lua_isnumber(L, i)) {
 						if (file->isEOF()) lua_pushnil(L);
 						auto n = lua_tointeger(L, i);
-						std::string s = file->readChars(n);
-						lua_pushlstring(L, s.c_str(), s.size());
+						size_t length = 0;
+						if (const char* data = file->peekChars(n, length)) {
+							lua_pushlstring(L, data, length);
+						} else {
+							std::string s = file->readChars(n);
+							lua_pushlstring(L, s.c_str(), s.size());
+						}
 					} else {
 						char fo = 'l';
 						if (lua_isstring(L, i)) {
@@ -319,14 +398,18 @@ namespace FicsItKernel {
 							break;
 						} case 'a':
 						{
-							std::string s = file->readAll();
-							lua_pushlstring(L, s.c_str(), s.size());
+							size_t length = 0;
+							if (const char* data = file->peekAll(length)) {
+								lua_pushlstring(L, data, length);
+							} else {
+								std::string s = file->readAll();
+								lua_pushlstring(L, s.c_str(), s.size());
+							}
 							break;
 						} case 'l':
 						{
 							if (!file->isEOF()) {
-								std::string s = file->readLine();
-								lua_pushlstring(L, s.c_str(), s.size());
+								luaPushLine(L, file);
 							} else lua_pushnil(L);
 							break;
 						}
@@ -345,10 +428,7 @@ namespace FicsItKernel {
 		LuaFileFunc(ReadLine, {
 			try {
 				if (file->isEOF()) lua_pushnil(L);
-				else {
-					std::string text = file->readLine().c_str();
-                    lua_pushlstring(L, text.c_str(), text.length());
-				}
+				else luaPushLine(L, file);
 			} CatchExceptionLua
 			return LuaProcessor::luaAPIReturn(L, 1);
 		})
@@ -374,11 +454,15 @@ namespace FicsItKernel {
 		})
 
 		LuaFileFunc(String, {
-			std::string text;
 			try {
-				text = file->readAll();
+				size_t length = 0;
+				if (const char* data = file->peekAll(length)) {
+					lua_pushlstring(L, data, length);
+				} else {
+					std::string text = file->readAll();
+					lua_pushlstring(L, text.c_str(), text.length());
+				}
 			} CatchExceptionLua
-			lua_pushlstring(L, text.c_str(), text.length());
 			return 1;
 		})
 
@@ -141,11 +141,11 @@ namespace FicsItKernel {
 			// check for network component stuff
 			if (NetworkHandler) {
 				if (MemberName == "id") {
-					lua_pushstring(L, TCHAR_TO_UTF8(*IFINNetworkComponent::Execute_GetID(NetworkHandler).ToString()));
+					lua_pushstring(L, TCHAR_TO_UTF8(*UFINNetworkUtils::GetNetworkComponentID(NetworkHandler).ToString()));
 					return LuaProcessor::luaAPIReturn(L, 1);
 				}
 				if (MemberName == "nick") {
-					lua_pushstring(L, TCHAR_TO_UTF8(*IFINNetworkComponent::Execute_GetNick(NetworkHandler)));
+					lua_pushstring(L, TCHAR_TO_UTF8(*UFINNetworkUtils::GetNetworkComponentNick(NetworkHandler)));
 					return LuaProcessor::luaAPIReturn(L, 1);
 				}
 			}
@@ -836,7 +836,8 @@ namespace FicsItKernel {
 			auto net = getKernel()->getNetwork();
 			if (!net || net->getSignalCount() < 1) return 0;
 			FFINNetworkTrace sender;
-			FFINSignalData signal = net->popSignal(sender);
+			int32 coalesceCount = 0;
+			FFINSignalData signal = net->popSignal(sender, &coalesceCount);
 			int props = 2;
 			if (signal.Signal) lua_pushstring(L, TCHAR_TO_UTF8(*signal.Signal->GetInternalName()));
 			else lua_pushnil(L);
@@ -845,6 +846,10 @@ namespace FicsItKernel {
 				networkValueToLua(L, Value);
 				props++;
 			}
+			if (coalesceCount > 0) {
+				lua_pushinteger(L, coalesceCount);
+				props++;
+			}
 			return props;
 		}
 #pragma optimize("", on)
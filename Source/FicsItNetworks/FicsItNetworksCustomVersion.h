@@ -15,6 +15,12 @@ enum EFINCustomVersion {
 	// Codeable Splitter Attachment Fixes
 	FINCodeableSplitterAttachmentFixes,
 
+	// Signal priority classes with sender priorities
+	FINSignalPriorities,
+
+	// Signal coalescing by sender and signal type
+	FINSignalCoalescing,
+
     // -----<new versions can be added above this line>-------------------------------------------------
     FINVersionPlusOne,
     FINLatestVersion = FINVersionPlusOne - 1
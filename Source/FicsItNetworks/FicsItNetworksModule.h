@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogFicsItNetworks, Log, Log);
+DECLARE_STATS_GROUP(TEXT("FicsIt-Networks"), STATGROUP_FicsItNetworks, STATCAT_Advanced);
 
 class FFicsItNetworksModule : public FDefaultGameModuleImpl
 {
@@ -51,6 +51,7 @@ public:
 	* This gets called by the bound screen if it is okay with destruction of the widget.
 	* F.e. when the widget goes out of view.
 	* Calls SetWidget of the screen with nullptr.
+	* The GPU may keep the widget cached to reuse it once a screen requests a new widget.
 	* GPU doesn't need to respond to the request.
 	*
 	* Client Only
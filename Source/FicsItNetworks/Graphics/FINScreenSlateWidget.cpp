@@ -0,0 +1,73 @@
+﻿#include "FINScreenSlateWidget.h"
+
+#include "SignificanceManager.h"
+#include "FicsItNetworksModule.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Screens"), STAT_FINActiveScreens, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Throttled Screens"), STAT_FINThrottledScreens, STATGROUP_FicsItNetworks);
+
+const FName FFINScreenSlateWidget::SignificanceTag = TEXT("FINScreen");
+
+void FFINScreenSlateWidget::Register(UWidgetComponent* Component) {
+	Unregister();
+	if (!Component) return;
+	WidgetComponent = Component;
+	
+	ScaleBox = SNew(SScaleBox).Stretch(EStretch::ScaleToFit);
+	WidgetComponent->SetSlateWidget(ScaleBox);
+	
+	bThrottled = false;
+	INC_DWORD_STAT(STAT_FINActiveScreens);
+
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(WidgetComponent->GetWorld());
+	if (SignificanceManager) {
+		const float MaxDistSq = SignificanceDistance * SignificanceDistance;
+		SignificanceManager->RegisterObject(WidgetComponent, SignificanceTag, [MaxDistSq](USignificanceManager::FManagedObjectInfo* Info, const FTransform& Viewpoint) -> float {
+			UWidgetComponent* Component = Cast<UWidgetComponent>(Info->GetObject());
+			if (!Component || !Component->WasRecentlyRendered(0.5f)) return 0.0f;
+			const float DistSq = FVector::DistSquared(Viewpoint.GetLocation(), Component->GetComponentLocation());
+			if (DistSq >= MaxDistSq) return 0.0f;
+			return 1.0f - DistSq / MaxDistSq;
+		}, USignificanceManager::EPostSignificanceType::Sequential, [this](USignificanceManager::FManagedObjectInfo* Info, float OldSignificance, float Significance, bool bFinal) {
+			SetThrottled(Significance <= 0.0f);
+		});
+	}
+}
+
+void FFINScreenSlateWidget::Unregister() {
+	if (!WidgetComponent) return;
+
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(WidgetComponent->GetWorld());
+	if (SignificanceManager) SignificanceManager->UnregisterObject(WidgetComponent);
+	
+	if (bThrottled) DEC_DWORD_STAT(STAT_FINThrottledScreens);
+	else DEC_DWORD_STAT(STAT_FINActiveScreens);
+	bThrottled = false;
+
+	if (ScaleBox.IsValid()) {
+		ScaleBox->SetContent(SNullWidget::NullWidget);
+		ScaleBox.Reset();
+	}
+	if (IsValid(WidgetComponent)) WidgetComponent->SetSlateWidget(nullptr);
+	WidgetComponent = nullptr;
+}
+
+void FFINScreenSlateWidget::SetContent(TSharedPtr<SWidget> Widget) {
+	if (!ScaleBox.IsValid()) return;
+	ScaleBox->SetContent(Widget.IsValid() ? Widget.ToSharedRef() : SNullWidget::NullWidget);
+	WidgetComponent->RequestRedraw();
+}
+
+void FFINScreenSlateWidget::SetThrottled(bool bInThrottled) {
+	if (bThrottled == bInThrottled || !WidgetComponent) return;
+	bThrottled = bInThrottled;
+	if (bThrottled) {
+		DEC_DWORD_STAT(STAT_FINActiveScreens);
+		INC_DWORD_STAT(STAT_FINThrottledScreens);
+	} else {
+		DEC_DWORD_STAT(STAT_FINThrottledScreens);
+		INC_DWORD_STAT(STAT_FINActiveScreens);
+	}
+	WidgetComponent->SetRedrawTime(bThrottled ? ThrottledRedrawTime : 0.0f);
+	if (!bThrottled) WidgetComponent->RequestRedraw();
+}
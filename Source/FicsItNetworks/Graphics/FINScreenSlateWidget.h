@@ -0,0 +1,66 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "SScaleBox.h"
+#include "WidgetComponent.h"
+
+/**
+ * Manages the slate widget displayed by the widget component of a screen.
+ * The scale box wrapping the GPU widget is kept for the lifetime of the screen and reused for every widget the GPU provides,
+ * so changing the GPU or widget only swaps the content instead of rebuilding the widget tree.
+ * The screen also gets registered in the significance manager, which throttles the redraw rate
+ * of the widget component while the screen is far away or not rendered at all.
+ *
+ * Client Only
+ */
+class FICSITNETWORKS_API FFINScreenSlateWidget {
+private:
+	UWidgetComponent* WidgetComponent = nullptr;
+	TSharedPtr<SScaleBox> ScaleBox;
+	bool bThrottled = false;
+
+public:
+	/**
+	 * The tag used to register screens in the significance manager
+	 */
+	static const FName SignificanceTag;
+
+	/**
+	 * The distance after which a screen gets throttled
+	 */
+	float SignificanceDistance = 5000.0f;
+
+	/**
+	 * The time in seconds between two redraws of a throttled screen
+	 */
+	float ThrottledRedrawTime = 0.5f;
+
+	/**
+	 * Creates the scale box, sets it as slate widget of the given widget component
+	 * and registers the component in the significance manager.
+	 *
+	 * @param[in]	Component	the widget component of the screen
+	 */
+	void Register(UWidgetComponent* Component);
+
+	/**
+	 * Unregisters the widget component from the significance manager
+	 * and releases the scale box.
+	 */
+	void Unregister();
+
+	/**
+	 * Sets the widget which should get displayed by the screen.
+	 * Pass nullptr to display nothing.
+	 *
+	 * @param[in]	Widget	the new widget of the screen
+	 */
+	void SetContent(TSharedPtr<SWidget> Widget);
+
+	/**
+	 * Changes the redraw rate of the widget component based on if the screen is significant or not.
+	 *
+	 * @param[in]	bInThrottled	true if the screen should redraw at a lower rate
+	 */
+	void SetThrottled(bool bInThrottled);
+};
@@ -10,9 +10,11 @@
 #include "FINAdvancedNetworkConnectionComponent.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFINHandleSignal, const FFINSignalData&, Signal, const FFINNetworkTrace&, Sender);
-DECLARE_MULTICAST_DELEGATE_FiveParams(FFINHandleNetworkMessage, FGuid, FGuid, FGuid, int, const TArray<FFINAnyNetworkValue>&);
+DECLARE_MULTICAST_DELEGATE_SixParams(FFINHandleNetworkMessage, FGuid, FGuid, FGuid, int, const TArray<FFINAnyNetworkValue>&, const FFINNetworkMessageRouting&);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FFINNetworkUpdated, int, const TSet<UObject*>&);
 DECLARE_DELEGATE_RetVal(bool, FFINIsNetworkRouter);
 DECLARE_DELEGATE_RetVal_OneParam(bool, FFINIsNetworkPortOpen, int);
+DECLARE_DELEGATE_RetVal_OneParam(bool, FFINIsInNetworkGroup, int);
 
 /**
  * This network connectionc component allows for cabled connections and additionally
@@ -35,9 +37,12 @@ protected:
 	 * The nick of this computer network component.
 	 * Used to group components and give them an alias.
 	 */
-	UPROPERTY(SaveGame, Replicated)
+	UPROPERTY(SaveGame, ReplicatedUsing=OnRep_Nick)
 	FString Nick;
 
+	UFUNCTION()
+	void OnRep_Nick();
+
 	/**
 	 * Used to check if the ID is already generated.
 	 */
@@ -64,17 +69,25 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Network|Connector")
 	FFINHandleSignal OnNetworkSignal;
 
+	/**
+	 * This event gets called if the circuit of this connector changed.
+	 */
+	FFINNetworkUpdated OnNetworkUpdated;
+
 	FFINHandleNetworkMessage OnNetworkMessageRecieved;
 	FFINIsNetworkRouter OnIsNetworkRouter;
 	FFINIsNetworkPortOpen OnIsNetworkPortOpen;
+	FFINIsInNetworkGroup OnIsInNetworkGroup;
 
 	UFINAdvancedNetworkConnectionComponent();
 	~UFINAdvancedNetworkConnectionComponent();
 	
-	// Begin AActor
+	// Begin UActorComponent
 	virtual void BeginPlay() override;
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 	virtual void Serialize(FArchive& Ar) override;
-	// End AActor
+	// End UActorComponent
 
 	// Begin IFGSaveInterface
 	bool ShouldSave_Implementation() const override;
@@ -103,8 +116,9 @@ public:
 
 	// Begin IFINNetworkMessageInterface
 	virtual bool IsPortOpen(int Port) override;
-	virtual void HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data) override;
+	virtual void HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data, const FFINNetworkMessageRouting& Routing) override;
 	virtual bool IsNetworkMessageRouter() const override;
+	virtual bool IsInGroup(int Group) override;
 	// End IFINNetworkMessageInterface
 
 	/**
@@ -1,6 +1,8 @@
 #include "FINAdvancedNetworkConnectionComponent.h"
 
 #include "FINNetworkCircuit.h"
+#include "FINNetworkCircuitSubsystem.h"
+#include "FINNetworkUtils.h"
 #include "UnrealNetwork.h"
 #include "Engine/World.h"
 
@@ -20,6 +22,7 @@ void UFINAdvancedNetworkConnectionComponent::BeginPlay() {
 	Super::BeginPlay();
 	
 	if (bOuterAsRedirect) RedirectionObject = GetOuter();
+	UFINNetworkUtils::InvalidateNetworkComponentCache(this);
 
 	if (GetOwner()->HasAuthority()) {
 		if (!bIdCreated) {
@@ -29,12 +32,29 @@ void UFINAdvancedNetworkConnectionComponent::BeginPlay() {
 
 		// setup circuit
 		if (!Circuit) {
-			Circuit = GetWorld()->SpawnActor<AFINNetworkCircuit>();
+			Circuit = AFINNetworkCircuitSubsystem::GetCircuitSubsystem(this)->CreateCircuit();
 			Circuit->Recalculate(this);
 		}
 	}
 }
 
+void UFINAdvancedNetworkConnectionComponent::OnRegister() {
+	Super::OnRegister();
+
+	UFINNetworkUtils::InvalidateNetworkComponentCache(GetOwner());
+}
+
+void UFINAdvancedNetworkConnectionComponent::OnUnregister() {
+	Super::OnUnregister();
+
+	UFINNetworkUtils::InvalidateNetworkComponentCache(GetOwner());
+	UFINNetworkUtils::InvalidateNetworkComponentCache(this);
+}
+
+void UFINAdvancedNetworkConnectionComponent::OnRep_Nick() {
+	UFINNetworkUtils::InvalidateNetworkComponentCache(this);
+}
+
 void UFINAdvancedNetworkConnectionComponent::Serialize(FArchive& Ar) {
 	Super::Serialize(Ar);
 }
@@ -44,6 +64,7 @@ bool UFINAdvancedNetworkConnectionComponent::ShouldSave_Implementation() const {
 }
 
 void UFINAdvancedNetworkConnectionComponent::NotifyNetworkUpdate_Implementation(int Type, const TSet<UObject*>& Nodes) {
+	OnNetworkUpdated.Broadcast(Type, Nodes);
 	for (UObject* Node : Nodes) {
 		if (Node->GetClass()->ImplementsInterface(UFINNetworkComponent::StaticClass())) {
 			netSig_NetworkUpdate(Type, IFINNetworkComponent::Execute_GetID(Node).ToString());
@@ -61,6 +82,7 @@ FString UFINAdvancedNetworkConnectionComponent::GetNick_Implementation() const {
 
 void UFINAdvancedNetworkConnectionComponent::SetNick_Implementation(const FString& NewNick) {
 	Nick = NewNick;
+	UFINNetworkUtils::InvalidateNetworkComponentCache(this);
 	GetOwner()->ForceNetUpdate();
 }
 
@@ -91,8 +113,8 @@ bool UFINAdvancedNetworkConnectionComponent::IsPortOpen(int Port) {
 	return false;
 }
 
-void UFINAdvancedNetworkConnectionComponent::HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data) {
-	OnNetworkMessageRecieved.Broadcast(ID, Sender, Receiver, Port, Data);
+void UFINAdvancedNetworkConnectionComponent::HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data, const FFINNetworkMessageRouting& Routing) {
+	OnNetworkMessageRecieved.Broadcast(ID, Sender, Receiver, Port, Data, Routing);
 }
 
 bool UFINAdvancedNetworkConnectionComponent::IsNetworkMessageRouter() const {
@@ -102,4 +124,11 @@ bool UFINAdvancedNetworkConnectionComponent::IsNetworkMessageRouter() const {
 	return false;
 }
 
+bool UFINAdvancedNetworkConnectionComponent::IsInGroup(int Group) {
+	if (OnIsInNetworkGroup.IsBound()) {
+		return OnIsInNetworkGroup.Execute(Group);
+	}
+	return false;
+}
+
 void UFINAdvancedNetworkConnectionComponent::netSig_NetworkUpdate_Implementation(int type, const FString& id) {}
@@ -3,6 +3,7 @@
 #include "FGPowerConnectionComponent.h"
 #include "FGItemPickup_Spawnable.h"
 #include "FINNetworkCable.h"
+#include "FINNetworkUtils.h"
 #include "UnrealNetwork.h"
 
 #include "Components/SceneComponent.h"
@@ -76,6 +77,7 @@ void AFINNetworkAdapter::BeginPlay() {
 	}
 	
 	Connector->RedirectionObject = Parent;
+	UFINNetworkUtils::InvalidateNetworkComponentCache(Connector);
 	
 	Attachment = NewObject<UFINNetworkAdapterReference>((Parent) ? Parent : nullptr);
 	Attachment->Ref = this;
@@ -130,3 +132,15 @@ void AFINNetworkAdapter::GatherDependencies_Implementation(TArray<UObject*>& out
 UFINNetworkAdapterReference::UFINNetworkAdapterReference() {}
 
 UFINNetworkAdapterReference::~UFINNetworkAdapterReference() {}
+
+void UFINNetworkAdapterReference::OnRegister() {
+	Super::OnRegister();
+
+	UFINNetworkUtils::InvalidateNetworkComponentCache(GetOwner());
+}
+
+void UFINNetworkAdapterReference::OnUnregister() {
+	Super::OnUnregister();
+
+	UFINNetworkUtils::InvalidateNetworkComponentCache(GetOwner());
+}
@@ -81,4 +81,9 @@ public:
 
 	UFINNetworkAdapterReference();
 	~UFINNetworkAdapterReference();
+
+	// Begin UActorComponent
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	// End UActorComponent
 };
\ No newline at end of file
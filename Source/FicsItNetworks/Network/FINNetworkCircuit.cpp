@@ -1,86 +1,191 @@
 #include "FINNetworkCircuit.h"
 
 #include "FINNetworkComponent.h"
+#include "FINNetworkMessageInterface.h"
+#include "FINNetworkCircuitSubsystem.h"
 #include "UnrealNetwork.h"
+#include "FicsItNetworksModule.h"
 
-void AFINNetworkCircuit::AddNodeRecursive(TSet<TScriptInterface<IFINNetworkCircuitNode>>& Added, TScriptInterface<IFINNetworkCircuitNode> Add) {
-	if (Add.GetObject() && !Added.Contains(Add)) {
-		Added.Add(Add);
-		Nodes.AddUnique(Add.GetObject());
-		IFINNetworkCircuitNode::Execute_SetCircuit(Add.GetObject(), this);
-		TSet<UObject*> ConNodes = IFINNetworkCircuitNode::Execute_GetConnected(Add.GetObject());
-		for (UObject* Node : ConNodes) {
-			AddNodeRecursive(Added, Node);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Circuit Node Bytes Replicated"), STAT_FINCircuitNodeBytesReplicated, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Circuit Node Changes"), STAT_FINCircuitNodeChanges, STATGROUP_FicsItNetworks);
+
+void FFINNetworkCircuitNodeItem::PostReplicatedAdd(const FFINNetworkCircuitNodeList& List) {
+	if (!List.Circuit) return;
+	List.Circuit->Nodes.Add(Node);
+	UObject* Obj = Node.Get();
+	if (Obj) List.Circuit->NodeSet.Add(Obj);
+}
+
+void FFINNetworkCircuitNodeItem::PreReplicatedRemove(const FFINNetworkCircuitNodeList& List) {
+	if (!List.Circuit) return;
+	List.Circuit->Nodes.RemoveSingleSwap(Node);
+	UObject* Obj = Node.Get();
+	if (Obj) List.Circuit->NodeSet.Remove(Obj);
+}
+
+bool FFINNetworkCircuitNodeList::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms) {
+	int64 StartBits = DeltaParms.Writer ? DeltaParms.Writer->GetNumBits() : 0;
+	bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<FFINNetworkCircuitNodeItem, FFINNetworkCircuitNodeList>(Items, DeltaParms, *this);
+	if (DeltaParms.Writer) {
+		INC_DWORD_STAT_BY(STAT_FINCircuitNodeBytesReplicated, (DeltaParms.Writer->GetNumBits() - StartBits + 7) / 8);
+	}
+	return bResult;
+}
+
+void UFINNetworkCircuit::AddNode(const TSoftObjectPtr<UObject>& Node) {
+	Nodes.Add(Node);
+	ReplicatedNodes.MarkItemDirty(ReplicatedNodes.Items.Add_GetRef(FFINNetworkCircuitNodeItem(Node)));
+	INC_DWORD_STAT(STAT_FINCircuitNodeChanges);
+	GetSubsystem()->ForceNetUpdate();
+}
+
+void UFINNetworkCircuit::RemoveNodes(const TSet<UObject*>& Removed) {
+	Nodes.RemoveAllSwap([&Removed](const TSoftObjectPtr<UObject>& Node) {
+		return Removed.Contains(Node.Get());
+	});
+	ReplicatedNodes.Items.RemoveAllSwap([&Removed](const FFINNetworkCircuitNodeItem& Item) {
+		return Removed.Contains(Item.Node.Get());
+	});
+	ReplicatedNodes.MarkArrayDirty();
+	for (UObject* Node : Removed) NodeSet.Remove(Node);
+	INC_DWORD_STAT_BY(STAT_FINCircuitNodeChanges, Removed.Num());
+	GetSubsystem()->ForceNetUpdate();
+}
+
+void UFINNetworkCircuit::ClearNodes() {
+	INC_DWORD_STAT_BY(STAT_FINCircuitNodeChanges, Nodes.Num());
+	Nodes.Empty();
+	NodeSet.Empty();
+	ReplicatedNodes.Items.Empty();
+	ReplicatedNodes.MarkArrayDirty();
+	GetSubsystem()->ForceNetUpdate();
+}
+
+void UFINNetworkCircuit::AddNodesFrom(UObject* Start) {
+	TArray<UObject*> Stack;
+	Stack.Add(Start);
+	while (Stack.Num() > 0) {
+		UObject* Obj = Stack.Pop(false);
+		if (!Obj) continue;
+		bool bAlreadyAdded = false;
+		NodeSet.Add(Obj, &bAlreadyAdded);
+		if (bAlreadyAdded) continue;
+		AddNode(Obj);
+		UFINNetworkCircuit* OldCircuit = IFINNetworkCircuitNode::Execute_GetCircuit(Obj);
+		if (OldCircuit && OldCircuit != this) GetSubsystem()->MarkForRelease(OldCircuit);
+		IFINNetworkCircuitNode::Execute_SetCircuit(Obj, this);
+		for (UObject* Node : IFINNetworkCircuitNode::Execute_GetConnected(Obj)) {
+			if (Node && !NodeSet.Contains(Node)) Stack.Add(Node);
 		}
 	}
 }
 
-AFINNetworkCircuit::AFINNetworkCircuit() {
-	bReplicates = true;
-	bAlwaysRelevant = true;
+UFINNetworkCircuit* UFINNetworkCircuit::SplitNodes(const TSet<UObject*>& Moved) {
+	UFINNetworkCircuit* NewCircuit = GetSubsystem()->CreateCircuit();
+	for (UObject* Node : Moved) {
+		NewCircuit->AddNode(Node);
+		NewCircuit->NodeSet.Add(Node);
+		IFINNetworkCircuitNode::Execute_SetCircuit(Node, NewCircuit);
+	}
+	RemoveNodes(Moved);
+
+	// one update per resulting circuit, each tells the nodes of the circuit about the nodes of the other part
+	GetSubsystem()->QueueNetworkUpdate(this, 1, TSet<UObject*>(Moved));
+	GetSubsystem()->QueueNetworkUpdate(NewCircuit, 1, TSet<UObject*>(NodeSet));
+
+	IFINNetworkMessageInterface::NotifyGroupsChanged();
+	return NewCircuit;
+}
+
+AFINNetworkCircuitSubsystem* UFINNetworkCircuit::GetSubsystem() const {
+	return Cast<AFINNetworkCircuitSubsystem>(GetOuter());
 }
 
-AFINNetworkCircuit::~AFINNetworkCircuit() {}
+bool UFINNetworkCircuit::HasAuthority() const {
+	AFINNetworkCircuitSubsystem* Subsystem = GetSubsystem();
+	return Subsystem && Subsystem->HasAuthority();
+}
+
+void UFINNetworkCircuit::PostInitProperties() {
+	Super::PostInitProperties();
 
-bool AFINNetworkCircuit::IsSupportedForNetworking() const {
+	ReplicatedNodes.Circuit = this;
+}
+
+bool UFINNetworkCircuit::IsSupportedForNetworking() const {
 	return true;
 }
 
-void AFINNetworkCircuit::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const {
+void UFINNetworkCircuit::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(AFINNetworkCircuit, Nodes);
+	DOREPLIFETIME(UFINNetworkCircuit, CircuitID);
+	DOREPLIFETIME(UFINNetworkCircuit, ReplicatedNodes);
 }
 
-AFINNetworkCircuit* AFINNetworkCircuit::operator+(AFINNetworkCircuit* Circuit) {
+UFINNetworkCircuit* UFINNetworkCircuit::operator+(UFINNetworkCircuit* Circuit) {
 	if (this == Circuit || !IsValid(Circuit)) return this;
 
-	AFINNetworkCircuit* From = Circuit;
-	AFINNetworkCircuit* To = this;
+	UFINNetworkCircuit* From = Circuit;
+	UFINNetworkCircuit* To = this;
 
 	if (Circuit->Nodes.Num() > Nodes.Num()) {
 		From = this;
 		To = Circuit;
 	}
 
-	TSet<UObject*> ToNodes;
-	for (const TSoftObjectPtr<UObject>& ToNode : To->Nodes) {
-		UObject* O = ToNode.Get();
-		if (O) ToNodes.Add(O);
-	}
+	TSet<UObject*> FromNodes;
 	for (const TSoftObjectPtr<UObject>& Node : From->Nodes) {
 		UObject* Obj = Node.Get();
 		if (!Obj) continue;
+		FromNodes.Add(Obj);
 		IFINNetworkCircuitNode::Execute_SetCircuit(Obj, To);
-		IFINNetworkCircuitNode::Execute_NotifyNetworkUpdate(Obj, 0, ToNodes);
 	}
 
-	TSet<UObject*> FromNodes;
-	for (const TSoftObjectPtr<UObject>& FromNode : From->Nodes) {
-		UObject* O = FromNode.Get();
-		if (O) FromNodes.Add(O);
-	}
-	for (const TSoftObjectPtr<UObject>& Node : To->Nodes) {
+	// one update per merged part, each tells the nodes of the part about the nodes of the other part
+	GetSubsystem()->QueueNetworkUpdate(To, 0, TSet<UObject*>(To->NodeSet));
+	GetSubsystem()->QueueNetworkUpdate(To, 0, TSet<UObject*>(FromNodes));
+
+	for (const TSoftObjectPtr<UObject>& Node : From->Nodes) {
 		UObject* Obj = Node.Get();
-		if (Obj) IFINNetworkCircuitNode::Execute_NotifyNetworkUpdate(Obj, 0, FromNodes);
+		if (!Obj) continue;
+		bool bAlreadyAdded = false;
+		To->NodeSet.Add(Obj, &bAlreadyAdded);
+		if (!bAlreadyAdded) To->AddNode(Node);
 	}
 
-	for (const TSoftObjectPtr<UObject>& Node : From->Nodes) To->Nodes.AddUnique(Node);
+	GetSubsystem()->MarkForRelease(From);
+	IFINNetworkMessageInterface::NotifyGroupsChanged();
 
 	return To;
 }
 
-void AFINNetworkCircuit::Recalculate(const TScriptInterface<IFINNetworkCircuitNode>& Node) {
-	Nodes.Empty();
+int32 UFINNetworkCircuit::GetCircuitID() const {
+	return CircuitID;
+}
 
-	TSet<TScriptInterface<IFINNetworkCircuitNode>> Added;
-	AddNodeRecursive(Added, Node);
+bool UFINNetworkCircuit::IsInUse() const {
+	for (const TSoftObjectPtr<UObject>& Node : Nodes) {
+		UObject* Obj = Node.Get();
+		if (IsValid(Obj) && IFINNetworkCircuitNode::Execute_GetCircuit(Obj) == this) return true;
+	}
+	return false;
+}
+
+void UFINNetworkCircuit::Recalculate(const TScriptInterface<IFINNetworkCircuitNode>& Node) {
+	ClearNodes();
+
+	AddNodesFrom(Node.GetObject());
+
+	IFINNetworkMessageInterface::NotifyGroupsChanged();
 }
 
-bool AFINNetworkCircuit::HasNode(const TScriptInterface<IFINNetworkCircuitNode>& Node) {
-	return Nodes.Find(Node.GetObject()) != INDEX_NONE;
+bool UFINNetworkCircuit::HasNode(const TScriptInterface<IFINNetworkCircuitNode>& Node) {
+	if (NodeSet.Contains(Node.GetObject())) return true;
+	// on clients the replicated nodes might not have been resolved when they got added to the index
+	return !HasAuthority() && Nodes.Find(Node.GetObject()) != INDEX_NONE;
 }
 
-TScriptInterface<IFINNetworkComponent> AFINNetworkCircuit::FindComponent(const FGuid& ID, const TScriptInterface<IFINNetworkComponent>& Requester) {
+TScriptInterface<IFINNetworkComponent> UFINNetworkCircuit::FindComponent(const FGuid& ID, const TScriptInterface<IFINNetworkComponent>& Requester) {
 	FGuid ReqID = (Requester) ? IFINNetworkComponent::Execute_GetID(Requester.GetObject()) : FGuid();
 	for (const TSoftObjectPtr<UObject>& node : Nodes) {
 		UObject* Obj = node.Get();
@@ -92,7 +197,7 @@ TScriptInterface<IFINNetworkComponent> AFINNetworkCircuit::FindComponent(const F
 	return nullptr;
 }
 
-TSet<UObject*> AFINNetworkCircuit::FindComponentsByNick(const FString& Nick, const TScriptInterface<IFINNetworkComponent>& Requester) {
+TSet<UObject*> UFINNetworkCircuit::FindComponentsByNick(const FString& Nick, const TScriptInterface<IFINNetworkComponent>& Requester) {
 	FGuid ReqID = (Requester) ? IFINNetworkComponent::Execute_GetID(Requester.GetObject()) : FGuid();
 	TSet<UObject*> Comps;
 	for (const TSoftObjectPtr<UObject>& Node : Nodes) {
@@ -103,7 +208,7 @@ TSet<UObject*> AFINNetworkCircuit::FindComponentsByNick(const FString& Nick, con
 	return Comps;
 }
 
-TSet<UObject*> AFINNetworkCircuit::GetComponents() {
+TSet<UObject*> UFINNetworkCircuit::GetComponents() {
 	TSet<UObject*> Comps;
 	for (const TSoftObjectPtr<UObject>& Node : Nodes) {
 		UObject* Obj = Node.Get();
@@ -112,53 +217,61 @@ TSet<UObject*> AFINNetworkCircuit::GetComponents() {
 	return Comps;
 }
 
-bool AFINNetworkCircuit::IsNodeConnected(const TScriptInterface<IFINNetworkCircuitNode>& Start, const TScriptInterface<IFINNetworkCircuitNode>& Node) {
+bool UFINNetworkCircuit::IsNodeConnected(const TScriptInterface<IFINNetworkCircuitNode>& Start, const TScriptInterface<IFINNetworkCircuitNode>& Node) {
 	TSet<UObject*> Searched;
 	return IsNodeConnected_Internal(Start, Node, Searched);
 }
 
-void AFINNetworkCircuit::DisconnectNodes(UObject* WorldContext, const TScriptInterface<IFINNetworkCircuitNode>& A, const TScriptInterface<IFINNetworkCircuitNode>& B) {
-	if (!IsNodeConnected(A, B)) {
-		AFINNetworkCircuit* CircuitA = IFINNetworkCircuitNode::Execute_GetCircuit(A.GetObject());
-		AFINNetworkCircuit* CircuitB = IFINNetworkCircuitNode::Execute_GetCircuit(B.GetObject());
-		if (CircuitA != CircuitB) return;
-		
-		CircuitA = WorldContext->GetWorld()->SpawnActor<AFINNetworkCircuit>();
-		IFINNetworkCircuitNode::Execute_SetCircuit(A.GetObject(), CircuitA);
-		CircuitA->Recalculate(A);
-
-		
-		TSet<UObject*> NodesA;
-		for (const TSoftObjectPtr<UObject>& Node : CircuitA->Nodes) {
-			UObject* Obj = Node.Get();
-			if (Obj) NodesA.Add(Obj);
+void UFINNetworkCircuit::DisconnectNodes(UObject* WorldContext, const TScriptInterface<IFINNetworkCircuitNode>& A, const TScriptInterface<IFINNetworkCircuitNode>& B) {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_FINNetworkCircuit_DisconnectNodes);
+	
+	UObject* ObjA = A.GetObject();
+	UObject* ObjB = B.GetObject();
+	if (!ObjA || !ObjB || ObjA == ObjB) return;
+	UFINNetworkCircuit* Circuit = IFINNetworkCircuitNode::Execute_GetCircuit(ObjA);
+	if (!Circuit || Circuit != IFINNetworkCircuitNode::Execute_GetCircuit(ObjB)) return;
+
+	// search from both nodes one step at a time,
+	// if one of the searches runs out of nodes, it found the complete smaller part of the split circuit
+	TSet<UObject*> VisitedA = {ObjA};
+	TSet<UObject*> VisitedB = {ObjB};
+	TArray<UObject*> QueueA = {ObjA};
+	TArray<UObject*> QueueB = {ObjB};
+	int32 IndexA = 0;
+	int32 IndexB = 0;
+	while (true) {
+		if (IndexA >= QueueA.Num()) {
+			Circuit->SplitNodes(VisitedA);
+			return;
 		}
-		TSet<UObject*> NodesB;
-		for (const TSoftObjectPtr<UObject>& Node : CircuitB->Nodes) {
-			UObject* Obj = Node.Get();
-			if (Obj) NodesB.Add(Obj);
+		if (IndexB >= QueueB.Num()) {
+			Circuit->SplitNodes(VisitedB);
+			return;
 		}
-
-		for (const TSoftObjectPtr<UObject>& Node : CircuitB->Nodes) {
-			if (CircuitB->Nodes.Contains(Node)) continue;
-			IFINNetworkCircuitNode::Execute_NotifyNetworkUpdate(Node.Get(), 1, NodesA);
+		for (UObject* Node : IFINNetworkCircuitNode::Execute_GetConnected(QueueA[IndexA++])) {
+			if (!Node) continue;
+			if (VisitedB.Contains(Node)) return;
+			bool bAlreadyVisited = false;
+			VisitedA.Add(Node, &bAlreadyVisited);
+			if (!bAlreadyVisited) QueueA.Add(Node);
 		}
-		CircuitB->Recalculate(B);
-		for (const TSoftObjectPtr<UObject>& Node : CircuitA->Nodes) {
-			if (CircuitA->Nodes.Contains(Node)) continue;
-			IFINNetworkCircuitNode::Execute_NotifyNetworkUpdate(Node.Get(), 1, NodesB);
+		for (UObject* Node : IFINNetworkCircuitNode::Execute_GetConnected(QueueB[IndexB++])) {
+			if (!Node) continue;
+			if (VisitedA.Contains(Node)) return;
+			bool bAlreadyVisited = false;
+			VisitedB.Add(Node, &bAlreadyVisited);
+			if (!bAlreadyVisited) QueueB.Add(Node);
 		}
 	}
 }
 
-void AFINNetworkCircuit::ConnectNodes(UObject* WorldContext, const TScriptInterface<IFINNetworkCircuitNode>& A, const TScriptInterface<IFINNetworkCircuitNode>& B) {
-	AFINNetworkCircuit* CircuitA = IFINNetworkCircuitNode::Execute_GetCircuit(A.GetObject());
-	AFINNetworkCircuit* CircuitB = IFINNetworkCircuitNode::Execute_GetCircuit(B.GetObject());
+void UFINNetworkCircuit::ConnectNodes(UObject* WorldContext, const TScriptInterface<IFINNetworkCircuitNode>& A, const TScriptInterface<IFINNetworkCircuitNode>& B) {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_FINNetworkCircuit_ConnectNodes);
+	
+	UFINNetworkCircuit* CircuitA = IFINNetworkCircuitNode::Execute_GetCircuit(A.GetObject());
+	UFINNetworkCircuit* CircuitB = IFINNetworkCircuitNode::Execute_GetCircuit(B.GetObject());
 	if (!CircuitB) {
-		FActorSpawnParameters Params;
-		Params.bNoFail = true;
-		CircuitB = WorldContext->GetWorld()->SpawnActor<AFINNetworkCircuit>(Params);
-		check(CircuitB);
+		CircuitB = AFINNetworkCircuitSubsystem::GetCircuitSubsystem(WorldContext)->CreateCircuit();
 		IFINNetworkCircuitNode::Execute_SetCircuit(B.GetObject(), CircuitB);
 		CircuitB->Recalculate(B);
 	}
@@ -168,12 +281,12 @@ void AFINNetworkCircuit::ConnectNodes(UObject* WorldContext, const TScriptInterf
 			IFINNetworkCircuitNode::Execute_SetCircuit(B.GetObject(), CircuitA);
 		}
 	} else {
-		IFINNetworkCircuitNode::Execute_SetCircuit(A.GetObject(), CircuitB);
-		CircuitB->Recalculate(A);
+		CircuitB->AddNodesFrom(A.GetObject());
+		IFINNetworkMessageInterface::NotifyGroupsChanged();
 	}
 }
 
-bool AFINNetworkCircuit::IsNodeConnected_Internal(const TScriptInterface<IFINNetworkCircuitNode>& Self, const TScriptInterface<IFINNetworkCircuitNode>& Node, TSet<UObject*>& Searched) {
+bool UFINNetworkCircuit::IsNodeConnected_Internal(const TScriptInterface<IFINNetworkCircuitNode>& Self, const TScriptInterface<IFINNetworkCircuitNode>& Node, TSet<UObject*>& Searched) {
 	if (Searched.Contains(Self.GetObject())) return false;
 	Searched.Add(Self.GetObject());
 
@@ -4,39 +4,158 @@
 #include "FINNetworkCircuitNode.h"
 #include "FINNetworkComponent.h"
 #include "Network/FINNetworkTrace.h"
+#include "Engine/NetSerialization.h"
 #include "FINNetworkCircuit.generated.h"
 
 class UFINAdvancedNetworkConnectionComponent;
+class UFINNetworkCircuit;
+class AFINNetworkCircuitSubsystem;
+struct FFINNetworkCircuitNodeList;
+
+/**
+ * A single node of a circuit in the replicated node list.
+ */
+USTRUCT()
+struct FFINNetworkCircuitNodeItem : public FFastArraySerializerItem {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSoftObjectPtr<UObject> Node;
+
+	FFINNetworkCircuitNodeItem() = default;
+	FFINNetworkCircuitNodeItem(const TSoftObjectPtr<UObject>& Node) : Node(Node) {}
+
+	void PostReplicatedAdd(const FFINNetworkCircuitNodeList& List);
+	void PreReplicatedRemove(const FFINNetworkCircuitNodeList& List);
+};
+
+/**
+ * The node list of a circuit which gets replicated as delta,
+ * so topology changes only send the added and removed nodes to the clients.
+ */
+USTRUCT()
+struct FFINNetworkCircuitNodeList : public FFastArraySerializer {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FFINNetworkCircuitNodeItem> Items;
+
+	UPROPERTY(NotReplicated)
+	UFINNetworkCircuit* Circuit = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FFINNetworkCircuitNodeList> : public TStructOpsTypeTraitsBase2<FFINNetworkCircuitNodeList> {
+	enum {
+		WithNetDeltaSerializer = true,
+	};
+};
 
 /**
  * Manages and caches a computer network circuit.
  * When changes occur in the network, also sends signals to the componentes accordingly.
+ * Circuits are lightweight objects owned, replicated and pooled by the circuit subsystem,
+ * create them only through AFINNetworkCircuitSubsystem::CreateCircuit.
  */
 UCLASS()
-class FICSITNETWORKS_API AFINNetworkCircuit : public AActor {
+class FICSITNETWORKS_API UFINNetworkCircuit : public UObject {
 	GENERATED_BODY()
 	
 	friend UFINAdvancedNetworkConnectionComponent;
+	friend FFINNetworkCircuitNodeItem;
+	friend AFINNetworkCircuitSubsystem;
 
 protected:
+	/**
+	 * The id of the circuit, unique in the world as long as the circuit is in use.
+	 * Gets reset when the circuit gets released to the pool.
+	 */
 	UPROPERTY(Replicated)
+	int32 CircuitID = 0;
+
+	/**
+	 * The nodes of the circuit.
+	 * Gets mirrored to the clients by the replicated node list.
+	 */
+	UPROPERTY()
 	TArray<TSoftObjectPtr<UObject>> Nodes;
 
-	void AddNodeRecursive(TSet<TScriptInterface<IFINNetworkCircuitNode>>& Added, TScriptInterface<IFINNetworkCircuitNode> Add);
+	/**
+	 * The replicated node list, only gets changed through AddNode, RemoveNodes and ClearNodes.
+	 */
+	UPROPERTY(Replicated)
+	FFINNetworkCircuitNodeList ReplicatedNodes;
+
+	/**
+	 * Index of the nodes array, allows to check in constant time if a node is part of the circuit.
+	 */
+	TSet<UObject*> NodeSet;
 
-public:
-	AFINNetworkCircuit();
-	~AFINNetworkCircuit();
+	/**
+	 * Adds the given node to the node list and marks it for replication.
+	 * Doesn't check if the node is already part of the circuit.
+	 */
+	void AddNode(const TSoftObjectPtr<UObject>& Node);
+
+	/**
+	 * Removes the given nodes from the node list and marks the removal for replication.
+	 */
+	void RemoveNodes(const TSet<UObject*>& Removed);
+
+	/**
+	 * Removes all nodes from the node list and marks the removal for replication.
+	 */
+	void ClearNodes();
+
+	/**
+	 * Adds the given node and all nodes connected to it to this circuit, if not already added.
+	 */
+	void AddNodesFrom(UObject* Start);
+
+	/**
+	 * Moves the given nodes from this circuit into a newly created circuit.
+	 *
+	 * @param[in]	Moved	the nodes you want to split of, need to form a complete connected component
+	 * @return	the new circuit
+	 */
+	UFINNetworkCircuit* SplitNodes(const TSet<UObject*>& Moved);
 
+	/**
+	 * Returns the circuit subsystem owning this circuit.
+	 */
+	AFINNetworkCircuitSubsystem* GetSubsystem() const;
+
+	/**
+	 * Returns true if this circuit is owned by the server instance of the subsystem.
+	 */
+	bool HasAuthority() const;
+
+public:
 	// Begin UObject
+	virtual void PostInitProperties() override;
 	virtual bool IsSupportedForNetworking() const override;
 	// End UObject
 	
 	/**
 	 * Adds the given circuit to this circuit.
+	 * The smaller of both circuits gets marked for release.
 	 * Causes correct update signals for the components.
 	 */
-	AFINNetworkCircuit* operator+(AFINNetworkCircuit* Circuit);
+	UFINNetworkCircuit* operator+(UFINNetworkCircuit* Circuit);
+
+	/**
+	 * Returns the id of the circuit.
+	 * Circuit objects get reused, so compare ids instead of the object if you keep a reference over time.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Network|Circuit")
+	int32 GetCircuitID() const;
+
+	/**
+	 * Checks if at least one of the nodes still uses this circuit.
+	 */
+	bool IsInUse() const;
 	
 	/**
 	 * Regenerates the node cache based on the given start component
@@ -83,8 +202,9 @@ public:
 
 	/**
 	 * Updates the circuits of node A and B after node B got removed
-	 * from the circuit of node A
-	 * by creating the new circuit, recalculating the circuits etc.
+	 * from the circuit of node A.
+	 * Searches from both nodes at the same time, so if the circuit got split,
+	 * only the nodes of the smaller part get visited and moved to a new circuit.
 	 * Should get called after the the nodes got disconnected
 	 *
 	 * @param[in]	A	the node whichs circuit should remove node B
@@ -95,7 +215,7 @@ public:
 
 	/**
 	 * Updates the circuits of node A and B after they got connected
-	 * by merging and recalculating the circuits.
+	 * by merging the smaller circuit into the larger one.
 	 * Should get called after the nodes got connected.
 	 *
 	 * @param[in]	A	the first component
@@ -5,7 +5,7 @@
 
 #include "FINNetworkCircuitNode.generated.h"
 
-class AFINNetworkCircuit;
+class UFINNetworkCircuit;
 
 /**
  * Everything that can be connected to a network circuit,
@@ -32,13 +32,13 @@ public:
 	* Returns the connected network circuit of this node.
 	*/
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Network|Component")
-    AFINNetworkCircuit* GetCircuit() const;
+    UFINNetworkCircuit* GetCircuit() const;
 
 	/**
 	* Sets the connected network circuit of this node.
 	*/
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Network|Component")
-    void SetCircuit(AFINNetworkCircuit* Circuit);
+    void SetCircuit(UFINNetworkCircuit* Circuit);
 
 	/**
 	* This functions gets executed when a change in the computer network circuit occured.
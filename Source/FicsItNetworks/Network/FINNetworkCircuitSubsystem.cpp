@@ -0,0 +1,132 @@
+﻿#include "FINNetworkCircuitSubsystem.h"
+
+#include "Engine/ActorChannel.h"
+#include "FINNetworkCircuit.h"
+#include "FINSubsystemHolder.h"
+#include "FicsItNetworksModule.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Circuits"), STAT_FINLiveCircuits, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Circuits"), STAT_FINPooledCircuits, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Circuits Created"), STAT_FINCircuitsCreated, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Circuits Released"), STAT_FINCircuitsReleased, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Circuit Update Batches"), STAT_FINCircuitUpdateBatches, STATGROUP_FicsItNetworks);
+DECLARE_CYCLE_STAT(TEXT("Flush Circuit Updates"), STAT_FINFlushCircuitUpdates, STATGROUP_FicsItNetworks);
+
+AFINNetworkCircuitSubsystem::AFINNetworkCircuitSubsystem() {
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+
+	SetReplicates(true);
+	bAlwaysRelevant = true;
+	// circuits force a net update when their nodes change
+	NetUpdateFrequency = 1.0f;
+}
+
+void AFINNetworkCircuitSubsystem::Tick(float DeltaSeconds) {
+	Super::Tick(DeltaSeconds);
+
+	if (!HasAuthority()) return;
+
+	FlushNetworkUpdates();
+
+	TimeSinceSweep += DeltaSeconds;
+	if (TimeSinceSweep >= SweepInterval) {
+		TimeSinceSweep = 0.0f;
+		for (UFINNetworkCircuit* Circuit : Circuits) ReleaseCandidates.Add(Circuit);
+	}
+
+	TArray<UFINNetworkCircuit*> Unused;
+	for (const TWeakObjectPtr<UFINNetworkCircuit>& Candidate : ReleaseCandidates) {
+		UFINNetworkCircuit* Circuit = Candidate.Get();
+		if (Circuit && Circuits.Contains(Circuit) && !Circuit->IsInUse()) Unused.Add(Circuit);
+	}
+	ReleaseCandidates.Empty();
+	for (UFINNetworkCircuit* Circuit : Unused) ReleaseCircuit(Circuit);
+}
+
+bool AFINNetworkCircuitSubsystem::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags) {
+	bool bWroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
+	for (UFINNetworkCircuit* Circuit : Circuits) {
+		bWroteSomething |= Channel->ReplicateSubobject(Circuit, *Bunch, *RepFlags);
+	}
+	return bWroteSomething;
+}
+
+AFINNetworkCircuitSubsystem* AFINNetworkCircuitSubsystem::GetCircuitSubsystem(UObject* WorldContext) {
+	return GetSubsystemHolder<UFINSubsystemHolder>(WorldContext)->CircuitSubsystem;
+}
+
+UFINNetworkCircuit* AFINNetworkCircuitSubsystem::CreateCircuit() {
+	UFINNetworkCircuit* Circuit;
+	if (Pool.Num() > 0) {
+		Circuit = Pool.Pop(false);
+		DEC_DWORD_STAT(STAT_FINPooledCircuits);
+	} else {
+		Circuit = NewObject<UFINNetworkCircuit>(this);
+	}
+	Circuit->CircuitID = NextCircuitID++;
+	Circuits.Add(Circuit);
+	INC_DWORD_STAT(STAT_FINLiveCircuits);
+	INC_DWORD_STAT(STAT_FINCircuitsCreated);
+	ForceNetUpdate();
+	return Circuit;
+}
+
+void AFINNetworkCircuitSubsystem::QueueNetworkUpdate(UFINNetworkCircuit* Circuit, int32 Type, TSet<UObject*>&& Nodes) {
+	if (!Circuit || Nodes.Num() < 1) return;
+	FFINNetworkCircuitUpdate& Update = PendingUpdates.AddDefaulted_GetRef();
+	Update.Circuit = Circuit;
+	Update.Type = Type;
+	Update.Nodes = MoveTemp(Nodes);
+}
+
+void AFINNetworkCircuitSubsystem::FlushNetworkUpdates() {
+	if (PendingUpdates.Num() < 1) return;
+	SCOPE_CYCLE_COUNTER(STAT_FINFlushCircuitUpdates);
+
+	// the nodes might have got destroyed since the update got queued
+	TMap<UFINNetworkCircuit*, TArray<FFINNetworkCircuitUpdate*>> Batches;
+	for (FFINNetworkCircuitUpdate& Update : PendingUpdates) {
+		if (!Circuits.Contains(Update.Circuit)) continue;
+		for (auto Node = Update.Nodes.CreateIterator(); Node; ++Node) {
+			if (!IsValid(*Node)) Node.RemoveCurrent();
+		}
+		if (Update.Nodes.Num() > 0) Batches.FindOrAdd(Update.Circuit).Add(&Update);
+	}
+
+	for (const TPair<UFINNetworkCircuit*, TArray<FFINNetworkCircuitUpdate*>>& Batch : Batches) {
+		INC_DWORD_STAT(STAT_FINCircuitUpdateBatches);
+		TArray<UObject*> Nodes;
+		Nodes.Reserve(Batch.Key->Nodes.Num());
+		for (const TSoftObjectPtr<UObject>& Node : Batch.Key->Nodes) {
+			UObject* Obj = Node.Get();
+			if (IsValid(Obj) && IFINNetworkCircuitNode::Execute_GetCircuit(Obj) == Batch.Key) Nodes.Add(Obj);
+		}
+		for (UObject* Node : Nodes) {
+			for (const FFINNetworkCircuitUpdate* Update : Batch.Value) {
+				if (!Update->Nodes.Contains(Node)) IFINNetworkCircuitNode::Execute_NotifyNetworkUpdate(Node, Update->Type, Update->Nodes);
+			}
+		}
+	}
+	PendingUpdates.Empty();
+}
+
+void AFINNetworkCircuitSubsystem::MarkForRelease(UFINNetworkCircuit* Circuit) {
+	if (Circuit) ReleaseCandidates.Add(Circuit);
+}
+
+void AFINNetworkCircuitSubsystem::ReleaseCircuit(UFINNetworkCircuit* Circuit) {
+	if (Circuits.Remove(Circuit) < 1) return;
+	PendingUpdates.RemoveAll([Circuit](const FFINNetworkCircuitUpdate& Update) {
+		return Update.Circuit == Circuit;
+	});
+	DEC_DWORD_STAT(STAT_FINLiveCircuits);
+	INC_DWORD_STAT(STAT_FINCircuitsReleased);
+	
+	Circuit->ClearNodes();
+	Circuit->CircuitID = 0;
+	if (Pool.Num() < MaxPoolSize) {
+		Pool.Add(Circuit);
+		INC_DWORD_STAT(STAT_FINPooledCircuits);
+	}
+}
@@ -0,0 +1,128 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "FGSubsystem.h"
+#include "FINNetworkCircuitSubsystem.generated.h"
+
+class UFINNetworkCircuit;
+
+/**
+ * A network update of a circuit which waits to get sent to the nodes of the circuit.
+ * All nodes of the circuit which are not part of the update nodes, get notified.
+ */
+USTRUCT()
+struct FFINNetworkCircuitUpdate {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UFINNetworkCircuit* Circuit = nullptr;
+
+	UPROPERTY()
+	int32 Type = 0;
+
+	UPROPERTY()
+	TSet<UObject*> Nodes;
+};
+
+/**
+ * Owns all network circuits of the world.
+ * Circuits are plain objects instead of actors, so they get replicated as subobjects of this subsystem
+ * and released circuits get pooled to be reused by the next circuit that gets created.
+ */
+UCLASS()
+class FICSITNETWORKS_API AFINNetworkCircuitSubsystem : public AFGSubsystem {
+	GENERATED_BODY()
+private:
+	/**
+	 * The circuits currently in use, only these get replicated.
+	 */
+	UPROPERTY()
+	TSet<UFINNetworkCircuit*> Circuits;
+
+	/**
+	 * Released circuits which can get reused.
+	 */
+	UPROPERTY()
+	TArray<UFINNetworkCircuit*> Pool;
+
+	/**
+	 * Circuits which might not be used by any node anymore,
+	 * get checked and released in the next tick.
+	 */
+	TSet<TWeakObjectPtr<UFINNetworkCircuit>> ReleaseCandidates;
+
+	/**
+	 * The network updates of this frame, get sent batched per circuit in the next tick.
+	 */
+	UPROPERTY()
+	TArray<FFINNetworkCircuitUpdate> PendingUpdates;
+
+	int32 NextCircuitID = 1;
+	float TimeSinceSweep = 0.0f;
+
+	/**
+	 * Removes the given circuit from the used circuits and adds it to the pool.
+	 */
+	void ReleaseCircuit(UFINNetworkCircuit* Circuit);
+
+	/**
+	 * Sends the pending network updates, walks the nodes of every changed circuit only once.
+	 */
+	void FlushNetworkUpdates();
+
+public:
+	/**
+	 * The max amount of released circuits kept for reuse.
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	int32 MaxPoolSize = 64;
+
+	/**
+	 * The time in seconds between two checks of all circuits for circuits not used by any node anymore.
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	float SweepInterval = 10.0f;
+
+	AFINNetworkCircuitSubsystem();
+
+	// Begin AActor
+	virtual void Tick(float DeltaSeconds) override;
+	virtual bool ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
+	// End AActor
+
+	/**
+	 * Gets the loaded circuit subsystem in the given world.
+	 *
+	 * @param[in]	WorldContext	the world context from were to load the circuit subsystem.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Network|Circuit", meta = (WorldContext = "WorldContext"))
+	static AFINNetworkCircuitSubsystem* GetCircuitSubsystem(UObject* WorldContext);
+
+	/**
+	 * Creates a new empty circuit with a new circuit id, reuses a pooled circuit if possible.
+	 *
+	 * Server Only
+	 */
+	UFINNetworkCircuit* CreateCircuit();
+
+	/**
+	 * Marks the given circuit to get checked if it's still used by any node in the next tick.
+	 * If not, it gets released.
+	 *
+	 * Server Only
+	 */
+	void MarkForRelease(UFINNetworkCircuit* Circuit);
+
+	/**
+	 * Queues a network update for the nodes of the given circuit.
+	 * All updates of a frame get sent together in the next tick,
+	 * so many cable changes in one frame don't walk the same circuit over and over again.
+	 *
+	 * Server Only
+	 *
+	 * @param[in]	Circuit		the circuit whichs nodes should get notified
+	 * @param[in]	Type		the type of the update, 0 if the nodes got added, 1 if the nodes got removed
+	 * @param[in]	Nodes		the nodes which got added or removed, they don't get notified themselves
+	 */
+	void QueueNetworkUpdate(UFINNetworkCircuit* Circuit, int32 Type, TSet<UObject*>&& Nodes);
+};
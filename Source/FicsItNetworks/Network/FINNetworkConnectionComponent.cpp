@@ -31,11 +31,11 @@ TSet<UObject*> UFINNetworkConnectionComponent::GetConnected_Implementation() con
 	return Connected;
 }
 
-AFINNetworkCircuit* UFINNetworkConnectionComponent::GetCircuit_Implementation() const {
+UFINNetworkCircuit* UFINNetworkConnectionComponent::GetCircuit_Implementation() const {
 	return Circuit;
 }
 
-void UFINNetworkConnectionComponent::SetCircuit_Implementation(AFINNetworkCircuit* NewCircuit) {
+void UFINNetworkConnectionComponent::SetCircuit_Implementation(UFINNetworkCircuit* NewCircuit) {
 	Circuit = NewCircuit;
 	GetOwner()->ForceNetUpdate();
 }
@@ -52,7 +52,7 @@ void UFINNetworkConnectionComponent::AddConnectedNode(TScriptInterface<IFINNetwo
 	UFINNetworkConnectionComponent* Obj = Cast<UFINNetworkConnectionComponent>(Node.GetObject());
 	if (Obj) Obj->AddConnectedNode(this);
 
-	AFINNetworkCircuit::ConnectNodes(this, this, Node);
+	UFINNetworkCircuit::ConnectNodes(this, this, Node);
 
 	GetOwner()->ForceNetUpdate();
 }
@@ -64,7 +64,7 @@ void UFINNetworkConnectionComponent::RemoveConnectedNode(TScriptInterface<IFINNe
 	UFINNetworkConnectionComponent* Obj = Cast<UFINNetworkConnectionComponent>(Node.GetObject());
 	if (Obj) Obj->ConnectedNodes.Remove(this);
 	
-	AFINNetworkCircuit::DisconnectNodes(this, this, Node);
+	UFINNetworkCircuit::DisconnectNodes(this, this, Node);
 
 	GetOwner()->ForceNetUpdate();
 }
@@ -82,7 +82,7 @@ bool UFINNetworkConnectionComponent::AddConnectedCable(AFINNetworkCable* Cable)
 	UFINNetworkConnectionComponent* OtherConnector = (Cable->Connector1 == this) ? ((Cable->Connector2 == this) ? nullptr : Cable->Connector2) : Cable->Connector1;
 	if (OtherConnector) {
 		OtherConnector->AddConnectedCable(Cable);
-		AFINNetworkCircuit::ConnectNodes(this, this, OtherConnector);
+		UFINNetworkCircuit::ConnectNodes(this, this, OtherConnector);
 	}
 
 	GetOwner()->ForceNetUpdate();
@@ -97,7 +97,7 @@ void UFINNetworkConnectionComponent::RemoveConnectedCable(AFINNetworkCable* Cabl
 		UFINNetworkConnectionComponent* OtherConnector = (Cable->Connector1 == this) ? Cable->Connector2 : Cable->Connector1;
 		if (OtherConnector) {
 			OtherConnector->ConnectedCables.Remove(Cable);
-			AFINNetworkCircuit::DisconnectNodes(OtherConnector->Circuit, this, OtherConnector);
+			UFINNetworkCircuit::DisconnectNodes(OtherConnector->Circuit, this, OtherConnector);
 		}
 	}
 
@@ -39,7 +39,7 @@ public:
 	 * The computer network circuit this connector is connected to.
 	 */
 	UPROPERTY(Replicated)
-	AFINNetworkCircuit* Circuit = nullptr;
+	UFINNetworkCircuit* Circuit = nullptr;
 
 	UFINNetworkConnectionComponent();
 	
@@ -49,8 +49,8 @@ public:
 	
 	// Begin IFINNetworkCircuitNode
 	virtual TSet<UObject*> GetConnected_Implementation() const override;
-	virtual AFINNetworkCircuit* GetCircuit_Implementation() const override;
-	virtual void SetCircuit_Implementation(AFINNetworkCircuit* Circuit) override;
+	virtual UFINNetworkCircuit* GetCircuit_Implementation() const override;
+	virtual void SetCircuit_Implementation(UFINNetworkCircuit* Circuit) override;
 	virtual void NotifyNetworkUpdate_Implementation(int Type, const TSet<UObject*>& Nodes) override;
 	// End IFINNetworkCircuitNode
 
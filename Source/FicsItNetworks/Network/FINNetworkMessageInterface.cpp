@@ -0,0 +1,11 @@
+﻿#include "FINNetworkMessageInterface.h"
+
+FThreadSafeCounter IFINNetworkMessageInterface::GroupEpoch;
+
+int32 IFINNetworkMessageInterface::GetGroupEpoch() {
+	return GroupEpoch.GetValue();
+}
+
+void IFINNetworkMessageInterface::NotifyGroupsChanged() {
+	GroupEpoch.Increment();
+}
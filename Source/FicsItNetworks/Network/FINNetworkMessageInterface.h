@@ -6,7 +6,42 @@
 
 #include "FINNetworkMessageInterface.generated.h"
 
-class AFINNetworkCircuit;
+class UFINNetworkCircuit;
+
+/**
+ * Routing information of a network message which gets passed along with the message from hop to hop.
+ */
+struct FICSITNETWORKS_API FFINNetworkMessageRouting {
+	/**
+	 * The amount of routers the message is still allowed to pass.
+	 * Routers decrement it on forward and drop the message once it reaches zero,
+	 * so messages can not loop forever in networks with router cycles.
+	 */
+	int HopLimit = 32;
+
+	/**
+	 * The router connector which forwarded the message into the current circuit.
+	 * nullptr if the message got sent directly by the sender.
+	 */
+	UObject* PreviousHop = nullptr;
+
+	/**
+	 * The packed binary values of the message, the data of the message is empty in this case.
+	 * Routers forward packed messages as they are without copying the bytes, only the receiving network card unpacks them.
+	 * Not valid if the message is not packed.
+	 */
+	TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Packed;
+
+	/**
+	 * The multicast group the message got sent to.
+	 * -1 if the message is not a multicast message.
+	 */
+	int Group = -1;
+
+	FFINNetworkMessageRouting() = default;
+	FFINNetworkMessageRouting(int HopLimit, UObject* PreviousHop) : HopLimit(HopLimit), PreviousHop(PreviousHop) {}
+};
+
 UINTERFACE(Blueprintable)
 class FICSITNETWORKS_API UFINNetworkMessageInterface : public UInterface {
 	GENERATED_BODY()
@@ -34,8 +69,9 @@ public:
 	 * @param[in]	Receiver		Guid containing the address of the receiver
 	 * @param[in]	Port			The port on which the message got sent
 	 * @param[in]	Data			The data frame of the message
+	 * @param[in]	Routing			The routing information like the remaining hop limit of the message
 	 */
-	virtual void HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const FINArray& Data) {};
+	virtual void HandleMessage(FGuid ID, FGuid Sender, FGuid Receiver, int Port, const FINArray& Data, const FFINNetworkMessageRouting& Routing) {};
 
 	/**
 	 * Allows to check if this network message handler is capable
@@ -48,4 +84,29 @@ public:
 	 * @return	True if this network message handler is a router
 	 */
 	virtual bool IsNetworkMessageRouter() const { return false; }
+
+	/**
+	 * Allows to check if this network message handler wants to receive
+	 * messages sent to the given multicast group.
+	 * Routers should return true if the group has members on the other side of the router.
+	 *
+	 * @param[in]	Group	the multicast group you want to check
+	 * @return	true if the message handler is interested in the group
+	 */
+	virtual bool IsInGroup(int Group) { return false; }
+
+	/**
+	 * Returns the current epoch of the multicast group memberships.
+	 * The epoch changes whenever a group membership or the topology of a network changes,
+	 * allowing routers to check if their cached group members are still valid.
+	 */
+	static int32 GetGroupEpoch();
+
+	/**
+	 * Notifies the routers that a group membership or the network topology changed.
+	 */
+	static void NotifyGroupsChanged();
+
+private:
+	static FThreadSafeCounter GroupEpoch;
 };
\ No newline at end of file
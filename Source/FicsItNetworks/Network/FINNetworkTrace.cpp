@@ -323,10 +323,10 @@ Step(UFINNetworkComponent, UFINNetworkComponent, {
 	return IFINNetworkCircuitNode::Execute_GetCircuit(oA)->HasNode(oB);
 })
 
-Step(UFINNetworkComponent, AFINNetworkCircuit, {
+Step(UFINNetworkComponent, UFINNetworkCircuit, {
 	return B->HasNode(oA);
 })
-Step(AFINNetworkCircuit, UFINNetworkComponent, {
+Step(UFINNetworkCircuit, UFINNetworkComponent, {
 	return A->HasNode(oB);
 })
 
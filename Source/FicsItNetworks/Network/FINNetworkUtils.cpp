@@ -5,26 +5,127 @@
 #include "FINNetworkComponent.h"
 #include "Components/ActorComponent.h"
 #include "GameFramework/Actor.h"
+#include "UObject/ObjectKey.h"
+
+namespace {
+	/**
+	 * Cached network component information of an object.
+	 * Every part gets resolved on first use.
+	 */
+	struct FFINNetworkComponentCacheEntry {
+		bool bComponentCached = false;
+		TWeakObjectPtr<UObject> Component;
+		bool bRedirectCached = false;
+		TWeakObjectPtr<UObject> Redirect;
+		FGuid ID;
+		bool bNickCached = false;
+		FString Nick;
+	};
+
+	/**
+	 * The cache entries keyed by the object they describe.
+	 * Object keys contain the serial number of the object, so entries of destroyed objects never get reused.
+	 */
+	TMap<FObjectKey, FFINNetworkComponentCacheEntry> NetworkComponentCache;
+	FRWLock NetworkComponentCacheLock;
+
+	const int32 MaxNetworkComponentCacheEntries = 16384;
+
+	FFINNetworkComponentCacheEntry& GetCacheEntry(UObject* Obj) {
+		if (NetworkComponentCache.Num() >= MaxNetworkComponentCacheEntries) {
+			for (auto Entry = NetworkComponentCache.CreateIterator(); Entry; ++Entry) {
+				if (!Entry->Key.ResolveObjectPtr()) Entry.RemoveCurrent();
+			}
+			if (NetworkComponentCache.Num() >= MaxNetworkComponentCacheEntries) NetworkComponentCache.Empty();
+		}
+		return NetworkComponentCache.FindOrAdd(FObjectKey(Obj));
+	}
+
+	UObject* FindNetworkComponentFromObjectUncached(UObject* Obj) {
+		if (Obj->Implements<UFINNetworkComponent>()) return Obj;
+		if (Obj->IsA<AActor>()) {
+			TArray<UActorComponent*> Connectors = Cast<AActor>(Obj)->GetComponentsByClass(UFINAdvancedNetworkConnectionComponent::StaticClass());
+			for (UActorComponent* Connector : Connectors) {
+				if (Connector->Implements<UFINNetworkComponent>()) return Connector;
+			}
+			TArray<UActorComponent*> Adapters = Cast<AActor>(Obj)->GetComponentsByClass(UFINNetworkAdapterReference::StaticClass());
+			if (Adapters.Num() > 0) return Cast<UFINNetworkAdapterReference>(Adapters[0])->Ref->Connector;
+		}
+		return nullptr;
+	}
+}
 
 UObject* UFINNetworkUtils::FindNetworkComponentFromObject(UObject* Obj) {
 	if (!Obj) return nullptr;
-	if (Obj->Implements<UFINNetworkComponent>()) return Obj;
-	if (Obj->IsA<AActor>()) {
-		TArray<UActorComponent*> Connectors = Cast<AActor>(Obj)->GetComponentsByClass(UFINAdvancedNetworkConnectionComponent::StaticClass());
-		for (UActorComponent* Connector : Connectors) {
-			if (Connector->Implements<UFINNetworkComponent>()) return Connector;
-		}
-		TArray<UActorComponent*> Adapters = Cast<AActor>(Obj)->GetComponentsByClass(UFINNetworkAdapterReference::StaticClass());
-		if (Adapters.Num() > 0) return Cast<UFINNetworkAdapterReference>(Adapters[0])->Ref->Connector;
+	{
+		FRWScopeLock Lock(NetworkComponentCacheLock, SLT_ReadOnly);
+		FFINNetworkComponentCacheEntry* Entry = NetworkComponentCache.Find(FObjectKey(Obj));
+		if (Entry && Entry->bComponentCached && Entry->Component.IsValid()) return Entry->Component.Get();
+	}
+	UObject* Component = FindNetworkComponentFromObjectUncached(Obj);
+	// misses don't get cached, the network component might get added to the object later on
+	if (!Component) return nullptr;
+	FRWScopeLock Lock(NetworkComponentCacheLock, SLT_Write);
+	FFINNetworkComponentCacheEntry& Entry = GetCacheEntry(Obj);
+	Entry.bComponentCached = true;
+	Entry.Component = Component;
+	return Component;
+}
+
+UObject* UFINNetworkUtils::GetInstanceRedirect(UObject* Component) {
+	if (!Component || !Component->Implements<UFINNetworkComponent>()) return nullptr;
+	{
+		FRWScopeLock Lock(NetworkComponentCacheLock, SLT_ReadOnly);
+		FFINNetworkComponentCacheEntry* Entry = NetworkComponentCache.Find(FObjectKey(Component));
+		if (Entry && Entry->bRedirectCached && !Entry->Redirect.IsStale()) return Entry->Redirect.Get();
+	}
+	UObject* Redirect = IFINNetworkComponent::Execute_GetInstanceRedirect(Component);
+	FRWScopeLock Lock(NetworkComponentCacheLock, SLT_Write);
+	FFINNetworkComponentCacheEntry& Entry = GetCacheEntry(Component);
+	Entry.bRedirectCached = true;
+	Entry.Redirect = Redirect;
+	return Redirect;
+}
+
+FGuid UFINNetworkUtils::GetNetworkComponentID(UObject* Component) {
+	if (!Component || !Component->Implements<UFINNetworkComponent>()) return FGuid();
+	{
+		FRWScopeLock Lock(NetworkComponentCacheLock, SLT_ReadOnly);
+		FFINNetworkComponentCacheEntry* Entry = NetworkComponentCache.Find(FObjectKey(Component));
+		if (Entry && Entry->ID.IsValid()) return Entry->ID;
+	}
+	FGuid ID = IFINNetworkComponent::Execute_GetID(Component);
+	// the id might not be generated yet, so only valid ids get cached
+	if (ID.IsValid()) {
+		FRWScopeLock Lock(NetworkComponentCacheLock, SLT_Write);
+		GetCacheEntry(Component).ID = ID;
 	}
-	return nullptr;
+	return ID;
+}
+
+FString UFINNetworkUtils::GetNetworkComponentNick(UObject* Component) {
+	if (!Component || !Component->Implements<UFINNetworkComponent>()) return FString();
+	{
+		FRWScopeLock Lock(NetworkComponentCacheLock, SLT_ReadOnly);
+		FFINNetworkComponentCacheEntry* Entry = NetworkComponentCache.Find(FObjectKey(Component));
+		if (Entry && Entry->bNickCached) return Entry->Nick;
+	}
+	FString Nick = IFINNetworkComponent::Execute_GetNick(Component);
+	FRWScopeLock Lock(NetworkComponentCacheLock, SLT_Write);
+	FFINNetworkComponentCacheEntry& Entry = GetCacheEntry(Component);
+	Entry.bNickCached = true;
+	Entry.Nick = Nick;
+	return Nick;
+}
+
+void UFINNetworkUtils::InvalidateNetworkComponentCache(UObject* Obj) {
+	FRWScopeLock Lock(NetworkComponentCacheLock, SLT_Write);
+	NetworkComponentCache.Remove(FObjectKey(Obj));
 }
 
 FFINNetworkTrace UFINNetworkUtils::RedirectIfPossible(const FFINNetworkTrace& Trace) {
 	UObject* Obj = Trace.GetUnderlyingPtr().Get();
-	if (Obj && Obj->Implements<UFINNetworkComponent>()) {
-		UObject* RedirectObj = IFINNetworkComponent::Execute_GetInstanceRedirect(Obj);
-		if (RedirectObj) return Trace / RedirectObj;
-	}
+	UObject* RedirectObj = GetInstanceRedirect(Obj);
+	if (RedirectObj) return Trace / RedirectObj;
 	return Trace;
 }
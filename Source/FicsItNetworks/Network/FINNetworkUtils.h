@@ -22,4 +22,29 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category="Network|Utils")
 	static FFINNetworkTrace RedirectIfPossible(const FFINNetworkTrace& Trace);
+
+	/**
+	 * Returns the instance redirect of the given network component.
+	 * The redirect gets cached, so repeated calls don't need to dispatch the interface function.
+	 * @param[in]	Component	the network component you want to get the redirect of
+	 * @return	the redirect object, nullptr if the component has no redirect or is not a network component
+	 */
+	static UObject* GetInstanceRedirect(UObject* Component);
+
+	/**
+	 * Returns the ID of the given network component, uses the network component cache.
+	 */
+	static FGuid GetNetworkComponentID(UObject* Component);
+
+	/**
+	 * Returns the nick of the given network component, uses the network component cache.
+	 */
+	static FString GetNetworkComponentNick(UObject* Component);
+
+	/**
+	 * Removes the cached information of the given object from the network component cache.
+	 * Needs to get called if the nick or the redirect of a network component changes,
+	 * or if a network component got added to or removed from the given actor.
+	 */
+	static void InvalidateNetworkComponentCache(UObject* Obj);
 };
@@ -43,6 +43,7 @@
 #include "Utils/FINTimeTableStop.h"
 #include "Utils/FINTrackGraph.h"
 #include "Utils/FINTargetPoint.h"
+#include "Computer/FINComputerGPUT1.h"
 
 TMap<UClass*, FFINStaticClassReg> UFINStaticReflectionSource::Classes;
 TMap<UScriptStruct*, FFINStaticStructReg> UFINStaticReflectionSource::Structs;
@@ -1973,3 +1974,61 @@ BeginProp(RFloat, a, TFS("Alpha"), TFS("The alpha (opacity) portion of the color
 	self->A = Val;
 } EndProp()
 EndStruct()
+
+BeginStruct(FFINGPUT1Buffer, "GPUT1Buffer", TFS("GPU T1 Buffer"), TFS("A structure that holds a character grid with foreground and background colors, like the screen buffer of the GPU T1. Can get changed without any calls to the GPU and then get uploaded to the GPU in one call."))
+BeginFunc(getSize, TFS("Get Size"), TFS("Returns the size of the buffer."), 2) {
+	OutVal(0, RInt, width, TFS("Width"), TFS("The width of the buffer."))
+	OutVal(1, RInt, height, TFS("Height"), TFS("The height of the buffer."))
+	Body()
+	width = (FINInt)self->GetWidth();
+	height = (FINInt)self->GetHeight();
+} EndFunc()
+BeginFunc(setSize, TFS("Set Size"), TFS("Resizes the buffer and clears all its cells."), 2) {
+	InVal(0, RInt, width, TFS("Width"), TFS("The new width of the buffer."))
+	InVal(1, RInt, height, TFS("Height"), TFS("The new height of the buffer."))
+	Body()
+	self->SetSize(FMath::Clamp<int64>(width, 1, 300), FMath::Clamp<int64>(height, 1, 100), FFINGPUT1BufferPixel());
+} EndFunc()
+BeginFunc(get, TFS("Get"), TFS("Returns the character and colors of the cell at the given position."), 2) {
+	InVal(0, RInt, x, TFS("X"), TFS("The x coordinate of the cell."))
+	InVal(1, RInt, y, TFS("Y"), TFS("The y coordinate of the cell."))
+	OutVal(2, RString, c, TFS("Char"), TFS("The character of the cell."))
+	OutVal(3, RStruct<FLinearColor>, foreground, TFS("Foreground"), TFS("The foreground color of the cell."))
+	OutVal(4, RStruct<FLinearColor>, background, TFS("Background"), TFS("The background color of the cell."))
+	Body()
+	FFINGPUT1BufferPixel Pixel = self->Get(x, y);
+	c = FString::Chr(Pixel.Character);
+	foreground = (FINAny)Pixel.Foreground.ReinterpretAsLinear();
+	background = (FINAny)Pixel.Background.ReinterpretAsLinear();
+} EndFunc()
+BeginFunc(setText, TFS("Set Text"), TFS("Draws the given text at the given position with the given colors, like setText of the GPU does."), 2) {
+	InVal(0, RInt, x, TFS("X"), TFS("The x coordinate at which the text should get drawn."))
+	InVal(1, RInt, y, TFS("Y"), TFS("The y coordinate at which the text should get drawn."))
+	InVal(2, RString, text, TFS("Text"), TFS("The text you want to draw."))
+	InVal(3, RStruct<FLinearColor>, foreground, TFS("Foreground"), TFS("The foreground color of the drawn text."))
+	InVal(4, RStruct<FLinearColor>, background, TFS("Background"), TFS("The background color of the drawn text."))
+	Body()
+	self->SetText(x, y, text, foreground.ToFColor(false), background.ToFColor(false));
+} EndFunc()
+BeginFunc(fill, TFS("Fill"), TFS("Fills the given rectangle with the given character and colors, like fill of the GPU does."), 2) {
+	InVal(0, RInt, x, TFS("X"), TFS("The x coordinate of the upper-left corner of the rectangle."))
+	InVal(1, RInt, y, TFS("Y"), TFS("The y coordinate of the upper-left corner of the rectangle."))
+	InVal(2, RInt, w, TFS("Width"), TFS("The width of the rectangle."))
+	InVal(3, RInt, h, TFS("Height"), TFS("The height of the rectangle."))
+	InVal(4, RString, c, TFS("Char"), TFS("The character you want to fill the rectangle with."))
+	InVal(5, RStruct<FLinearColor>, foreground, TFS("Foreground"), TFS("The foreground color of the rectangle."))
+	InVal(6, RStruct<FLinearColor>, background, TFS("Background"), TFS("The background color of the rectangle."))
+	Body()
+	self->Fill(x, y, w, h, FFINGPUT1BufferPixel(FFINGPUT1Buffer::GetFillChar(c), foreground.ToFColor(false), background.ToFColor(false)));
+} EndFunc()
+BeginFunc(copy, TFS("Copy"), TFS("Copies the cells of the given rectangle by the given offset, like copy of the GPU does."), 2) {
+	InVal(0, RInt, x, TFS("X"), TFS("The x coordinate of the upper-left corner of the rectangle."))
+	InVal(1, RInt, y, TFS("Y"), TFS("The y coordinate of the upper-left corner of the rectangle."))
+	InVal(2, RInt, w, TFS("Width"), TFS("The width of the rectangle."))
+	InVal(3, RInt, h, TFS("Height"), TFS("The height of the rectangle."))
+	InVal(4, RInt, dx, TFS("DX"), TFS("The amount of columns the rectangle gets moved by."))
+	InVal(5, RInt, dy, TFS("DY"), TFS("The amount of rows the rectangle gets moved by."))
+	Body()
+	self->Copy(x, y, w, h, dx, dy);
+} EndFunc()
+EndStruct()
@@ -1,5 +1,11 @@
 #include "FINLuaCodeEditor.h"
 
+#include "FicsItNetworksModule.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lua Syntax Highlight"), STAT_FINLuaSyntaxHighlight, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lua Syntax Highlight Parsed Lines"), STAT_FINLuaSyntaxHighlightParsedLines, STATGROUP_FicsItNetworks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lua Syntax Highlight Cached Lines"), STAT_FINLuaSyntaxHighlightCachedLines, STATGROUP_FicsItNetworks);
+
 const FName FFINLuaCodeEditorStyle::TypeName(TEXT("FFINLuaCodeEditorStyle"));
 
 FFINLuaCodeEditorStyle::FFINLuaCodeEditorStyle() {}
@@ -37,230 +43,282 @@ TSharedRef<FFINLuaSyntaxHighlighterTextLayoutMarshaller> FFINLuaSyntaxHighlighte
 	
 	return MakeShareable(new FFINLuaSyntaxHighlighterTextLayoutMarshaller(MakeShared<FSyntaxTokenizer>(TokenizerRules), LuaSyntaxTextStyle));
 }
-#pragma optimize("", off)
+void FFINLuaSyntaxHighlighterTextLayoutMarshaller::SetText(const FString& SourceString, FTextLayout& TargetTextLayout) {
+	if (!IsSyntaxHighlightingEnabled()) {
+		FPlainTextLayoutMarshaller::SetText(SourceString, TargetTextLayout);
+		return;
+	}
+	
+	SCOPE_CYCLE_COUNTER(STAT_FINLuaSyntaxHighlight);
+	
+	TArray<FTextRange> LineRanges;
+	FTextRange::CalculateLineRangesFromString(SourceString, LineRanges);
+
+	TArray<FTextLayout::FNewLineData> LinesToAdd;
+	LinesToAdd.Reserve(LineRanges.Num());
+
+	// only lines of the current text stay cached, so the cache doesn't grow while editing
+	FLineCache NewLineCache[4];
+	bool bInString = false;
+	bool bInBlockComment = false;
+	int32 ParsedLines = 0;
+	for (const FTextRange& LineRange : LineRanges) {
+		FString LineString = SourceString.Mid(LineRange.BeginIndex, LineRange.Len());
+		const int32 State = (bInString ? 1 : 0) | (bInBlockComment ? 2 : 0);
+		
+		const FHighlightedLine* Line = NewLineCache[State].Find(LineString);
+		if (!Line) {
+			FHighlightedLine* CachedLine = LineCache[State].Find(LineString);
+			if (CachedLine) {
+				Line = &NewLineCache[State].Add(LineString, MoveTemp(*CachedLine));
+				LineCache[State].Remove(LineString);
+			} else {
+				TArray<FSyntaxTokenizer::FTokenizedLine> TokenizedLines;
+				Tokenizer->Process(TokenizedLines, LineString);
+				FHighlightedLine NewLine;
+				NewLine.bInString = bInString;
+				NewLine.bInBlockComment = bInBlockComment;
+				if (TokenizedLines.Num() > 0) ParseLine(LineString, TokenizedLines[0], NewLine.bInString, NewLine.bInBlockComment, NewLine.Runs);
+				Line = &NewLineCache[State].Add(LineString, MoveTemp(NewLine));
+				++ParsedLines;
+			}
+		}
+
+		bInString = Line->bInString;
+		bInBlockComment = Line->bInBlockComment;
+		LinesToAdd.Add(MakeLine(LineString, Line->Runs));
+	}
+	for (int32 i = 0; i < 4; ++i) LineCache[i] = MoveTemp(NewLineCache[i]);
+
+	INC_DWORD_STAT_BY(STAT_FINLuaSyntaxHighlightParsedLines, ParsedLines);
+	INC_DWORD_STAT_BY(STAT_FINLuaSyntaxHighlightCachedLines, LineRanges.Num() - ParsedLines);
+
+	TargetTextLayout.AddLines(LinesToAdd);
+}
+
 void FFINLuaSyntaxHighlighterTextLayoutMarshaller::ParseTokens(const FString& SourceString, FTextLayout& TargetTextLayout, TArray<FSyntaxTokenizer::FTokenizedLine> TokenizedLines) {
 	TArray<FTextLayout::FNewLineData> LinesToAdd;
 	LinesToAdd.Reserve(TokenizedLines.Num());
 
 	bool bInString = false;
 	bool bInBlockComment = false;
-	TSharedPtr<ISlateRun> Run;
 	for (const FSyntaxTokenizer::FTokenizedLine& TokenizedLine : TokenizedLines) {
-		TSharedRef<FString> ModelString = MakeShareable(new FString());
-		TArray<TSharedRef<IRun>> Runs;
+		TArray<FHighlightRun> Runs;
+		ParseLine(SourceString, TokenizedLine, bInString, bInBlockComment, Runs);
+		LinesToAdd.Add(MakeLine(SourceString.Mid(TokenizedLine.Range.BeginIndex, TokenizedLine.Range.Len()), Runs));
+	}
+	TargetTextLayout.AddLines(LinesToAdd);
+}
 
-		auto DoNormal = [&](FTextRange Range) {
-			if (Runs.Num() > 0 && Runs[Runs.Num()-1]->GetRunInfo().Name == "SyntaxHighlight.FINLua.Normal") {
-				Range.BeginIndex = Runs[Runs.Num()-1]->GetTextRange().BeginIndex;
-				Runs.Pop();
-			}
-			FTextBlockStyle Style = SyntaxTextStyle->NormalTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.Normal"));
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto DoComment = [&](const FTextRange& Range) {
-			FTextBlockStyle Style = SyntaxTextStyle->CommentTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.Comment"));
-			RunInfo.MetaData.Add("Splitting");
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto DoString = [&](const FTextRange& Range) {
-			FTextBlockStyle Style = SyntaxTextStyle->StringTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.String"));
-			RunInfo.MetaData.Add("Splitting");
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto DoKeyword = [&](const FTextRange& Range) {
-			FTextBlockStyle Style = SyntaxTextStyle->KeywordTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.Keyword"));
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto DoTrue = [&](const FTextRange& Range) {
-			FTextBlockStyle Style = SyntaxTextStyle->BoolTrueTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.Keyword"));
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto DoFalse = [&](const FTextRange& Range) {
-			FTextBlockStyle Style = SyntaxTextStyle->BoolFalseTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.Keyword"));
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto DoNumber = [&](const FTextRange& Range) {
-			FTextBlockStyle Style = SyntaxTextStyle->NumberTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.Number"));
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto DoWhitespace = [&](const FTextRange& Range) {
-			FTextBlockStyle Style = SyntaxTextStyle->NormalTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.Whitespace"));
-			RunInfo.MetaData.Add("Splitting");
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto DoOperator = [&](const FTextRange& Range, bool bColored) {
-			FTextBlockStyle Style = bColored ? SyntaxTextStyle->OperatorTextStyle : SyntaxTextStyle->NormalTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.Operator"));
-			RunInfo.MetaData.Add("Splitting");
-			RunInfo.MetaData.Add("Operator", ModelString->Mid(Range.BeginIndex, Range.Len()));
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto DoFunction = [&](const FTextRange& Range, bool bDeclaration) {
-			FTextBlockStyle Style = bDeclaration ? SyntaxTextStyle->FunctionDeclarationTextStyle : SyntaxTextStyle->FunctionCallTextStyle;
-			FRunInfo RunInfo(TEXT("SyntaxHighlight.FINLua.Function"));
-			Run = FSlateTextRun::Create(RunInfo, ModelString, Style, Range);
-			Runs.Add(Run.ToSharedRef());
-		};
-		auto FindPrevNoWhitespaceRun = [&](int32 StartIndex = -1) {
-			if (StartIndex < 0) StartIndex = Runs.Num()-1;
-			for (int i = StartIndex; i >= 0; i--) {
-				if (Runs[i]->GetRunInfo().Name != "SyntaxHighlight.FINLua.Whitespace") {
-					return i;
-				}
-			}
-			return -1;
-		};
-
-		int StringStart = 0;
-		int StringEnd = 0;
-		bool bInNumber = false;
-		bool bNumberHadDecimal = false;
-		bool bInLineComment = false;
-		for (const FSyntaxTokenizer::FToken& Token : TokenizedLine.Tokens) {
-			const FString TokenString = SourceString.Mid(Token.Range.BeginIndex, Token.Range.Len());
-			int Start = ModelString->Len();
-			int End = Start + TokenString.Len();
-			ModelString->Append(TokenString);
-
-			bool bIsNew = !Run.IsValid() || Start < 1 || Run->GetRunInfo().MetaData.Contains("Splitting");
-			
-			if (bInString || bInLineComment || bInBlockComment) {
-				StringEnd += TokenString.Len();
+FTextLayout::FNewLineData FFINLuaSyntaxHighlighterTextLayoutMarshaller::MakeLine(const FString& LineString, const TArray<FHighlightRun>& Runs) {
+	TSharedRef<FString> ModelString = MakeShared<FString>(LineString);
+	TArray<TSharedRef<IRun>> LineRuns;
+	LineRuns.Reserve(Runs.Num());
+	for (const FHighlightRun& Run : Runs) {
+		LineRuns.Add(FSlateTextRun::Create(Run.RunInfo, ModelString, *Run.Style, Run.Range));
+	}
+	return FTextLayout::FNewLineData(ModelString, MoveTemp(LineRuns));
+}
+
+void FFINLuaSyntaxHighlighterTextLayoutMarshaller::ParseLine(const FString& SourceString, const FSyntaxTokenizer::FTokenizedLine& TokenizedLine, bool& bInString, bool& bInBlockComment, TArray<FHighlightRun>& Runs) const {
+	static const TSet<FString> Keywords = {"while", "for", "in", "do", "if", "then", "elseif", "else", "end", "local", "not", "and", "or", "function", "return"};
+	static const TSet<FString> Whitespaces = {" ", "\t"};
+	static const TSet<FString> Operators = {".", ",", ":", "(", ")", "[", "]", "{", "}"};
+	static const TSet<FString> ColoredOperators = {"+", "-", "*", "/", "%", "#", "=", "~", "!", ">", "<"};
+	
+	FString ModelString;
+	ModelString.Reserve(TokenizedLine.Range.Len());
+	FHighlightRun Run;
+	bool bHasRun = false;
+
+	auto AddRun = [&](const TCHAR* Name, const FTextBlockStyle& Style, const FTextRange& Range, bool bSplitting) {
+		Run.RunInfo = FRunInfo(Name);
+		if (bSplitting) Run.RunInfo.MetaData.Add("Splitting");
+		Run.Style = &Style;
+		Run.Range = Range;
+		bHasRun = true;
+		Runs.Add(Run);
+	};
+	auto DoNormal = [&](FTextRange Range) {
+		if (Runs.Num() > 0 && Runs[Runs.Num()-1].RunInfo.Name == "SyntaxHighlight.FINLua.Normal") {
+			Range.BeginIndex = Runs[Runs.Num()-1].Range.BeginIndex;
+			Runs.Pop();
+		}
+		AddRun(TEXT("SyntaxHighlight.FINLua.Normal"), SyntaxTextStyle->NormalTextStyle, Range, false);
+	};
+	auto DoComment = [&](const FTextRange& Range) {
+		AddRun(TEXT("SyntaxHighlight.FINLua.Comment"), SyntaxTextStyle->CommentTextStyle, Range, true);
+	};
+	auto DoString = [&](const FTextRange& Range) {
+		AddRun(TEXT("SyntaxHighlight.FINLua.String"), SyntaxTextStyle->StringTextStyle, Range, true);
+	};
+	auto DoKeyword = [&](const FTextRange& Range) {
+		AddRun(TEXT("SyntaxHighlight.FINLua.Keyword"), SyntaxTextStyle->KeywordTextStyle, Range, false);
+	};
+	auto DoTrue = [&](const FTextRange& Range) {
+		AddRun(TEXT("SyntaxHighlight.FINLua.Keyword"), SyntaxTextStyle->BoolTrueTextStyle, Range, false);
+	};
+	auto DoFalse = [&](const FTextRange& Range) {
+		AddRun(TEXT("SyntaxHighlight.FINLua.Keyword"), SyntaxTextStyle->BoolFalseTextStyle, Range, false);
+	};
+	auto DoNumber = [&](const FTextRange& Range) {
+		AddRun(TEXT("SyntaxHighlight.FINLua.Number"), SyntaxTextStyle->NumberTextStyle, Range, false);
+	};
+	auto DoWhitespace = [&](const FTextRange& Range) {
+		AddRun(TEXT("SyntaxHighlight.FINLua.Whitespace"), SyntaxTextStyle->NormalTextStyle, Range, true);
+	};
+	auto DoOperator = [&](const FTextRange& Range, bool bColored) {
+		AddRun(TEXT("SyntaxHighlight.FINLua.Operator"), bColored ? SyntaxTextStyle->OperatorTextStyle : SyntaxTextStyle->NormalTextStyle, Range, true);
+		Runs.Last().RunInfo.MetaData.Add("Operator", ModelString.Mid(Range.BeginIndex, Range.Len()));
+		Run = Runs.Last();
+	};
+	auto DoFunction = [&](const FTextRange& Range, bool bDeclaration) {
+		AddRun(TEXT("SyntaxHighlight.FINLua.Function"), bDeclaration ? SyntaxTextStyle->FunctionDeclarationTextStyle : SyntaxTextStyle->FunctionCallTextStyle, Range, false);
+	};
+	auto FindPrevNoWhitespaceRun = [&](int32 StartIndex = -1) {
+		if (StartIndex < 0) StartIndex = Runs.Num()-1;
+		for (int i = StartIndex; i >= 0; i--) {
+			if (Runs[i].RunInfo.Name != "SyntaxHighlight.FINLua.Whitespace") {
+				return i;
 			}
-			if (!bInBlockComment && !bInLineComment && (TokenString == "\"" || TokenString == "\'")) {
-				if (bInString) {
-					if (Start > 0 && (*ModelString)[Start-1] == '\\') continue;
-					DoString(FTextRange(StringStart, StringEnd));
-					bInString = false;
-					continue;
-				}
-				bInString = true;
-				StringStart = Start;
-				StringEnd = End;
+		}
+		return -1;
+	};
+	auto IsDigits = [](const FString& String) {
+		if (String.Len() < 1) return false;
+		for (TCHAR Char : String) {
+			if (!FChar::IsDigit(Char)) return false;
+		}
+		return true;
+	};
+
+	int StringStart = 0;
+	int StringEnd = 0;
+	bool bInNumber = false;
+	bool bNumberHadDecimal = false;
+	bool bInLineComment = false;
+	for (const FSyntaxTokenizer::FToken& Token : TokenizedLine.Tokens) {
+		const FString TokenString = SourceString.Mid(Token.Range.BeginIndex, Token.Range.Len());
+		int Start = ModelString.Len();
+		int End = Start + TokenString.Len();
+		ModelString.Append(TokenString);
+
+		bool bIsNew = !bHasRun || Start < 1 || Run.RunInfo.MetaData.Contains("Splitting");
+		
+		if (bInString || bInLineComment || bInBlockComment) {
+			StringEnd += TokenString.Len();
+		}
+		if (!bInBlockComment && !bInLineComment && (TokenString == "\"" || TokenString == "\'")) {
+			if (bInString) {
+				if (Start > 0 && ModelString[Start-1] == '\\') continue;
+				DoString(FTextRange(StringStart, StringEnd));
+				bInString = false;
 				continue;
 			}
-			if (!bInString) {
-				if (TokenString == "--[[" && !bInBlockComment && !bInLineComment) {
-					if (!bInBlockComment) {
-						bInBlockComment = true;
-						StringStart = Start;
-						StringEnd = End;
-					}
-				} else if (TokenString == "]]--" && bInBlockComment) {
-					bInBlockComment = false;
-					DoComment(FTextRange(StringStart, StringEnd));
-					continue;
-				} else if (TokenString == "--" && !bInLineComment && !bInBlockComment) {
-					bInLineComment = true;
+			bInString = true;
+			StringStart = Start;
+			StringEnd = End;
+			continue;
+		}
+		if (!bInString) {
+			if (TokenString == "--[[" && !bInBlockComment && !bInLineComment) {
+				if (!bInBlockComment) {
+					bInBlockComment = true;
 					StringStart = Start;
 					StringEnd = End;
 				}
+			} else if (TokenString == "]]--" && bInBlockComment) {
+				bInBlockComment = false;
+				DoComment(FTextRange(StringStart, StringEnd));
+				continue;
+			} else if (TokenString == "--" && !bInLineComment && !bInBlockComment) {
+				bInLineComment = true;
+				StringStart = Start;
+				StringEnd = End;
 			}
-			if (bInString || bInLineComment || bInBlockComment) continue;
-			if (bInNumber) {
-				bool bStillNumber = false;
-				if (TokenString == ".") {
-					if (!bNumberHadDecimal) {
-						bNumberHadDecimal = true;
-						bStillNumber = true;
-					}
-				} else if (FRegexMatcher(FRegexPattern("^[0-9]+$"), TokenString).FindNext()) bStillNumber = true;
-				if (bStillNumber) {
-					StringEnd += TokenString.Len();
-					continue;
+		}
+		if (bInString || bInLineComment || bInBlockComment) continue;
+		if (bInNumber) {
+			bool bStillNumber = false;
+			if (TokenString == ".") {
+				if (!bNumberHadDecimal) {
+					bNumberHadDecimal = true;
+					bStillNumber = true;
 				}
-				DoNumber(FTextRange(StringStart, StringEnd));
-				bIsNew = true;
-				bInNumber = false;
+			} else if (IsDigits(TokenString)) bStillNumber = true;
+			if (bStillNumber) {
+				StringEnd += TokenString.Len();
+				continue;
 			}
+			DoNumber(FTextRange(StringStart, StringEnd));
+			bIsNew = true;
+			bInNumber = false;
+		}
 
-			if (Token.Type == FSyntaxTokenizer::ETokenType::Syntax) {
-				if (bIsNew) {
-					if (TArray<FString>({"while", "for", "in", "do", "if", "then", "elseif", "else", "end", "local", "not", "and", "or", "function", "return"}).Contains(TokenString)) {
-						DoKeyword(FTextRange(Start, End));
-						continue;
-					} else if (TokenString == "true") {
-						DoTrue(FTextRange(Start, End));
-						continue;
-					} else if (TokenString == "false") {
-						DoFalse(FTextRange(Start, End));
-						continue;
-					}
-				}
-				if (TokenString == "(") {
-					int Index = FindPrevNoWhitespaceRun();
-					if (Index >= 0 && Runs[Index]->GetRunInfo().Name == "SyntaxHighlight.FINLua.Normal") {
-						FTextRange OldRange = Runs[Index]->GetTextRange();
-						Runs.RemoveAt(Index);
-						int KeywordIndex = FindPrevNoWhitespaceRun(Index-1);
-						FString Keyword;
-						if (KeywordIndex >= 0) Keyword = ModelString->Mid(Runs[KeywordIndex]->GetTextRange().BeginIndex, Runs[KeywordIndex]->GetTextRange().EndIndex - Runs[KeywordIndex]->GetTextRange().BeginIndex);
-                        DoFunction(OldRange, KeywordIndex >= 0 && Runs[KeywordIndex]->GetRunInfo().Name == "SyntaxHighlight.FINLua.Keyword" && Keyword == "function");
-						TSharedRef<IRun> NewRun = Runs[Runs.Num()-1];
-						Runs.RemoveAt(Runs.Num()-1);
-						Runs.Insert(NewRun, Index);
-						DoOperator(FTextRange(Start, End), false);
-						continue;
-					}
-				}
-				if (TArray<FString>({" ","\t"}).Contains(TokenString)) {
-					DoWhitespace(FTextRange(Start, End));
+		if (Token.Type == FSyntaxTokenizer::ETokenType::Syntax) {
+			if (bIsNew) {
+				if (Keywords.Contains(TokenString)) {
+					DoKeyword(FTextRange(Start, End));
 					continue;
-				}
-				if (TArray<FString>({".",",",":","(",")","[","]","{","}"}).Contains(TokenString)) {
-					DoOperator(FTextRange(Start, End), false);
+				} else if (TokenString == "true") {
+					DoTrue(FTextRange(Start, End));
 					continue;
-				}
-				if (TArray<FString>({"+","-","*","/","%","#","=","~","!",">","<"}).Contains(TokenString)) {
-					DoOperator(FTextRange(Start, End), true);
+				} else if (TokenString == "false") {
+					DoFalse(FTextRange(Start, End));
 					continue;
 				}
-			} else {
-				if (!bIsNew) {
-					FTextRange ModelRange = Run->GetTextRange();
-					Runs.RemoveAt(Runs.Num()-1);
-					DoNormal(ModelRange);
-					bIsNew = false;
-				} else if (TokenString.IsNumeric()) {
-					bInNumber = true;
-					StringStart = Start;
-					StringEnd = End;
+			}
+			if (TokenString == "(") {
+				int Index = FindPrevNoWhitespaceRun();
+				if (Index >= 0 && Runs[Index].RunInfo.Name == "SyntaxHighlight.FINLua.Normal") {
+					FTextRange OldRange = Runs[Index].Range;
+					Runs.RemoveAt(Index);
+					int KeywordIndex = FindPrevNoWhitespaceRun(Index-1);
+					FString Keyword;
+					if (KeywordIndex >= 0) Keyword = ModelString.Mid(Runs[KeywordIndex].Range.BeginIndex, Runs[KeywordIndex].Range.Len());
+					DoFunction(OldRange, KeywordIndex >= 0 && Runs[KeywordIndex].RunInfo.Name == "SyntaxHighlight.FINLua.Keyword" && Keyword == "function");
+					FHighlightRun NewRun = Runs.Pop();
+					Runs.Insert(NewRun, Index);
+					DoOperator(FTextRange(Start, End), false);
 					continue;
 				}
 			}
-			DoNormal(FTextRange(Start, End));
-		}
-		
-		if (bInNumber) {
-			DoNumber(FTextRange(StringStart, StringEnd));
-		} else if (bInString) {
-			DoString(FTextRange(StringStart, StringEnd));
-		} else if (bInLineComment || bInBlockComment) {
-			DoComment(FTextRange(StringStart, StringEnd));
+			if (Whitespaces.Contains(TokenString)) {
+				DoWhitespace(FTextRange(Start, End));
+				continue;
+			}
+			if (Operators.Contains(TokenString)) {
+				DoOperator(FTextRange(Start, End), false);
+				continue;
+			}
+			if (ColoredOperators.Contains(TokenString)) {
+				DoOperator(FTextRange(Start, End), true);
+				continue;
+			}
+		} else {
+			if (!bIsNew) {
+				FTextRange ModelRange = Run.Range;
+				Runs.RemoveAt(Runs.Num()-1);
+				DoNormal(ModelRange);
+				bIsNew = false;
+			} else if (TokenString.IsNumeric()) {
+				bInNumber = true;
+				StringStart = Start;
+				StringEnd = End;
+				continue;
+			}
 		}
-		
-		LinesToAdd.Emplace(MoveTemp(ModelString), MoveTemp(Runs));
+		DoNormal(FTextRange(Start, End));
+	}
+	
+	if (bInNumber) {
+		DoNumber(FTextRange(StringStart, StringEnd));
+	} else if (bInString) {
+		DoString(FTextRange(StringStart, StringEnd));
+	} else if (bInLineComment || bInBlockComment) {
+		DoComment(FTextRange(StringStart, StringEnd));
 	}
-	TargetTextLayout.AddLines(LinesToAdd);
 }
-#pragma optimize("", on)
 
 void SFINLuaCodeEditor::Construct(const FArguments& InArgs) {
 	SyntaxHighlighter = FFINLuaSyntaxHighlighterTextLayoutMarshaller::Create(InArgs._CodeStyle);
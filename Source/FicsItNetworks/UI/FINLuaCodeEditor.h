@@ -61,9 +61,62 @@ public:
 
 	static TSharedRef<FFINLuaSyntaxHighlighterTextLayoutMarshaller> Create(const FFINLuaCodeEditorStyle* LuaSyntaxTextStyle);
 
+	// Begin ITextLayoutMarshaller
+	virtual void SetText(const FString& SourceString, FTextLayout& TargetTextLayout) override;
+	// End ITextLayoutMarshaller
+
 protected:
+	/**
+	 * A highlighted range of a line, turned into a text run once the line gets added to the text layout
+	 */
+	struct FHighlightRun {
+		FRunInfo RunInfo;
+		const FTextBlockStyle* Style;
+		FTextRange Range;
+	};
+
+	/**
+	 * The highlighted runs of a line and the string/comment state the next line starts with
+	 */
+	struct FHighlightedLine {
+		TArray<FHighlightRun> Runs;
+		bool bInString;
+		bool bInBlockComment;
+	};
+
+	/**
+	 * Lines only differing in case can get highlighted differently, so the line cache has to be case sensitive
+	 */
+	struct FLineCacheKeyFuncs : TDefaultMapKeyFuncs<FString, FHighlightedLine, false> {
+		static FORCEINLINE bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static FORCEINLINE uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+	typedef TMap<FString, FHighlightedLine, FDefaultSetAllocator, FLineCacheKeyFuncs> FLineCache;
+
+	/**
+	 * The highlighted lines of the last text, mapped by the line contents.
+	 * Index is the string/comment state the line starts with: bInString | bInBlockComment << 1
+	 */
+	FLineCache LineCache[4];
+
 	virtual void ParseTokens(const FString& SourceString, FTextLayout& TargetTextLayout, TArray<FSyntaxTokenizer::FTokenizedLine> TokenizedLines) override;
 
+	/**
+	 * Highlights the given tokenized line.
+	 *
+	 * @param[in]		SourceString	the string the token ranges refer to
+	 * @param[in]		TokenizedLine	the tokens of the line
+	 * @param[in,out]	bInString		true if the line starts in a string, set to true if the next line starts in a string
+	 * @param[in,out]	bInBlockComment	true if the line starts in a block comment, set to true if the next line starts in a block comment
+	 * @param[out]		OutRuns			the highlighted runs of the line
+	 */
+	void ParseLine(const FString& SourceString, const FSyntaxTokenizer::FTokenizedLine& TokenizedLine, bool& bInString, bool& bInBlockComment, TArray<FHighlightRun>& OutRuns) const;
+
+	/**
+	 * Creates the text runs of the given highlighted runs.
+	 */
+	static FTextLayout::FNewLineData MakeLine(const FString& LineString, const TArray<FHighlightRun>& Runs);
+
 	const FFINLuaCodeEditorStyle* SyntaxTextStyle;
 };
 
@@ -70,6 +70,7 @@ void SFINReflectionUI::Construct(const FArguments& InArgs) {
 				})
 				.OnCheckStateChanged_Lambda([this](ECheckBoxState State) {
 					this->Context.SetShowRecursive(State == ECheckBoxState::Checked);
+					FilterCache(this->Context.FilterString);
 				})
 			]
 		]
@@ -104,10 +105,17 @@ void SFINReflectionUI::Construct(const FArguments& InArgs) {
 SFINReflectionUI::SFINReflectionUI() {}
 
 void SFINReflectionUI::FilterCache(const FString& InFilter) {
-	Context.FilterString = InFilter.TrimStartAndEnd();
-	FFINReflectionUIFilter Filter(Context.FilterString);
-	Filtered.Empty();
-	for (const TSharedPtr<FFINReflectionUIEntry>& Entry : Context.Entries) {
+	FString NewFilter = InFilter.TrimStartAndEnd();
+	if (Context.bFilterValid && NewFilter.Equals(Context.FilterString, ESearchCase::IgnoreCase)) return;
+	
+	// if the new filter only extends the old one, only the previous results can still pass
+	bool bRefine = Context.bFilterValid && Context.FilterString.Len() > 0 && NewFilter.StartsWith(Context.FilterString);
+	Context.FilterString = NewFilter;
+	Context.bFilterValid = true;
+	FFINReflectionUIFilter Filter(Context.FilterString, bRefine);
+	TArray<TSharedPtr<FFINReflectionUIEntry>> Entries = bRefine ? MoveTemp(Filtered) : Context.Entries;
+	Filtered.Empty(Entries.Num());
+	for (const TSharedPtr<FFINReflectionUIEntry>& Entry : Entries) {
 		if (Entry->ApplyFilter(Filter)) Filtered.Add(Entry);
 	}
 	Tree->RequestTreeRefresh();
@@ -191,5 +199,6 @@ void UFINReflectionUI::NavigateTo(UFINStruct* InStruct) {
 void UFINReflectionUI::SetShowRecursive(bool bInShowRecursive) {
 	if (Container) {
 		Container->Context.SetShowRecursive(bInShowRecursive);
+		Container->FilterCache(Container->Context.FilterString);
 	}
 }
@@ -360,7 +360,8 @@ TSharedRef<SWidget> GeneratePropFlags(UFINProperty* Prop, FFINReflectionUIContex
 	return Box;
 }
 
-FFINReflectionUIFilter::FFINReflectionUIFilter(FString Filter) {
+FFINReflectionUIFilter::FFINReflectionUIFilter(FString Filter, bool bRefine) : bRefine(bRefine) {
+	Filter.ToLowerInline();
 	FString Token;
 	while (Filter.Split(" ", &Filter, &Token)) {
 		if (Token.Len() > 0) Tokens.Add(Token);
@@ -368,13 +369,17 @@ FFINReflectionUIFilter::FFINReflectionUIFilter(FString Filter) {
 	if (Filter.Len() > 0) Tokens.Add(Filter);
 }
 
-bool FFINReflectionUIFilter::PassesFilter(const FString& String) const {
+bool FFINReflectionUIFilter::PassesFilter(const FString& SearchText) const {
 	for (const FString& Token : Tokens) {
-		if (!String.Contains(Token)) return false;
+		if (!SearchText.Contains(Token, ESearchCase::CaseSensitive)) return false;
 	}
 	return true;
 }
 
+FString FFINReflectionUIEntry::MakeSearchText(const FText& DisplayName, const FString& InternalName) {
+	return (DisplayName.ToString() + TEXT(" ") + InternalName).ToLower();
+}
+
 void FFINReflectionUIEntry::UpdateChildren(bool bForce) {
 	if (bUpdateChildren || bForce) {
 		bUpdateChildren = false;
@@ -407,7 +412,14 @@ void FFINReflectionUIStruct::LoadChildren() {
 	}
 }
 
-FFINReflectionUIStruct::FFINReflectionUIStruct(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINStruct* Struct, FFINReflectionUIContext* Context) : FFINReflectionUIEntry(Parent, Context), Struct(Struct) {}
+FFINReflectionUIStruct::FFINReflectionUIStruct(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINStruct* Struct, FFINReflectionUIContext* Context) : FFINReflectionUIEntry(Parent, Context), Struct(Struct) {
+	SearchText = MakeSearchText(Struct->GetDisplayName(), Struct->GetInternalName());
+}
+
+void FFINReflectionUIStruct::GetFilterableChildren(TArray<TSharedPtr<FFINReflectionUIEntry>>& OutChildren) {
+	OutChildren.Append(Attributes);
+	OutChildren.Append(Functions);
+}
 
 TSharedRef<SWidget> FFINReflectionUIStruct::GetDetailsWidget() {
 	return SNew(SFINSplitter)
@@ -489,16 +501,19 @@ TSharedRef<SWidget> FFINReflectionUIStruct::GetPreview() {
 
 EFINReflectionFilterState FFINReflectionUIStruct::ApplyFilter(const FFINReflectionUIFilter& Filter) {
 	UpdateChildren();
-	Filtered.Empty();
 	TArray<TSharedPtr<FFINReflectionUIEntry>> Entries;
-	Entries.Append(Attributes);
-	Entries.Append(Functions);
+	if (Filter.bRefine) {
+		Entries = MoveTemp(Filtered);
+	} else {
+		GetFilterableChildren(Entries);
+	}
+	Filtered.Empty(Entries.Num());
 	for (const TSharedPtr<FFINReflectionUIEntry>& Entry : Entries) {
 		if (Entry->ApplyFilter(Filter)) {
 			Filtered.Add(Entry);
 		}
 	}
-	if (Filter.PassesFilter(Struct->GetDisplayName().ToString() + " " + Struct->GetInternalName())) return FIN_Ref_Filter_Self;
+	if (Filter.PassesFilter(SearchText)) return FIN_Ref_Filter_Self;
 	if (Filtered.Num() > 0) return FIN_Ref_Filter_Child;
 	return FIN_Ref_Filter_None;
 }
@@ -571,21 +586,19 @@ TSharedRef<SWidget> FFINReflectionUIClass::GetDetailsWidget() {
 	];
 }
 
-EFINReflectionFilterState FFINReflectionUIClass::ApplyFilter(const FFINReflectionUIFilter& Filter) {
-	EFINReflectionFilterState Passed = FFINReflectionUIStruct::ApplyFilter(Filter);
-	for (const TSharedPtr<FFINReflectionUIEntry>& Entry : Signals) {
-		if (Entry->ApplyFilter(Filter)) {
-			Filtered.Add(Entry);
-		}
-	}
-	if (Passed == FIN_Ref_Filter_None && Filtered.Num() > 0) return FIN_Ref_Filter_Child;
-	return Passed;
+void FFINReflectionUIClass::GetFilterableChildren(TArray<TSharedPtr<FFINReflectionUIEntry>>& OutChildren) {
+	FFINReflectionUIStruct::GetFilterableChildren(OutChildren);
+	OutChildren.Append(Signals);
 }
 
 UFINClass* FFINReflectionUIClass::GetClass() const {
 	return Cast<UFINClass>(GetStruct());
 }
 
+FFINReflectionUIProperty::FFINReflectionUIProperty(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINProperty* Property, FFINReflectionUIContext* Context) : FFINReflectionUIEntry(Parent, Context), Property(Property) {
+	SearchText = MakeSearchText(Property->GetDisplayName(), Property->GetInternalName());
+}
+
 TSharedRef<SWidget> FFINReflectionUIProperty::GetDetailsWidget() {
 	return SNew(SBox)
     .Padding(FMargin(0, 35, 35, 35))
@@ -678,10 +691,14 @@ TSharedRef<SWidget> FFINReflectionUIProperty::GetPreview() {
 }
 
 EFINReflectionFilterState FFINReflectionUIProperty::ApplyFilter(const FFINReflectionUIFilter& Filter) {
-	if (Filter.PassesFilter(Property->GetDisplayName().ToString() + " " + Property->GetInternalName())) return FIN_Ref_Filter_Self;
+	if (Filter.PassesFilter(SearchText)) return FIN_Ref_Filter_Self;
 	return FIN_Ref_Filter_None;
 }
 
+FFINReflectionUIFunction::FFINReflectionUIFunction(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINFunction* Function, FFINReflectionUIContext* Context) : FFINReflectionUIEntry(Parent, Context), Function(Function) {
+	SearchText = MakeSearchText(Function->GetDisplayName(), Function->GetInternalName());
+}
+
 void FFINReflectionUIFunction::LoadChildren() {
 	FFINReflectionUIEntry::LoadChildren();
 
@@ -852,10 +869,14 @@ TSharedRef<SWidget> FFINReflectionUIFunction::GetPreview() {
 }
 
 EFINReflectionFilterState FFINReflectionUIFunction::ApplyFilter(const FFINReflectionUIFilter& Filter) {
-	if (Filter.PassesFilter(Function->GetDisplayName().ToString() + " " + Function->GetInternalName())) return FIN_Ref_Filter_Self;
+	if (Filter.PassesFilter(SearchText)) return FIN_Ref_Filter_Self;
 	return FIN_Ref_Filter_None;
 }
 
+FFINReflectionUISignal::FFINReflectionUISignal(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINSignal* Signal, FFINReflectionUIContext* Context) : FFINReflectionUIEntry(Parent, Context), Signal(Signal) {
+	SearchText = MakeSearchText(Signal->GetDisplayName(), Signal->GetInternalName());
+}
+
 void FFINReflectionUISignal::LoadChildren() {
 	FFINReflectionUIEntry::LoadChildren();
 
@@ -1015,7 +1036,7 @@ TSharedRef<SWidget> FFINReflectionUISignal::GetPreview() {
 }
 
 EFINReflectionFilterState FFINReflectionUISignal::ApplyFilter(const FFINReflectionUIFilter& Filter) {
-	if (Filter.PassesFilter(Signal->GetDisplayName().ToString() + " " + Signal->GetInternalName())) return FIN_Ref_Filter_Self;
+	if (Filter.PassesFilter(SearchText)) return FIN_Ref_Filter_Self;
 	return FIN_Ref_Filter_None;
 }
 
@@ -1071,6 +1092,7 @@ FFINReflectionUIEntry* FFINReflectionUIContext::GetSelected() const {
 
 void FFINReflectionUIContext::SetShowRecursive(bool bInShowRecursive) {
 	bShowRecursive = bInShowRecursive;
+	bFilterValid = false;
 	for (const TSharedPtr<FFINReflectionUIEntry>& Entry : Entries) {
 		Entry->UpdateChildren(true);
 	}
@@ -28,15 +28,34 @@ class FFINReflectionUIFilter {
 private:
 	TArray<FString> Tokens;	
 public:
-	FFINReflectionUIFilter(FString Filter);
+	/**
+	 * True if this filter only narrows down the previously applied filter.
+	 * Entries which didn't pass the previous filter can't pass this one either,
+	 * so only the previously filtered children need to get checked again.
+	 */
+	bool bRefine = false;
 	
-	bool PassesFilter(const FString& String) const;
+	FFINReflectionUIFilter(FString Filter, bool bRefine = false);
+
+	/**
+	 * Checks if the given search text contains all tokens of the filter.
+	 * The search text has to be lower case, like the ones built by the entries.
+	 */
+	bool PassesFilter(const FString& SearchText) const;
 };
 
 class FFINReflectionUIEntry : public TSharedFromThis<FFINReflectionUIEntry> {
 protected:
 	virtual void LoadChildren() {};
 	bool bUpdateChildren = true;
+
+	/**
+	 * The lower case display and internal name of the entry the filter gets checked against.
+	 * Built once when the entry gets created, so filtering doesn't need to build strings per keystroke.
+	 */
+	FString SearchText;
+
+	static FString MakeSearchText(const FText& DisplayName, const FString& InternalName);
 	
 public:
 	TWeakPtr<FFINReflectionUIEntry> Parent;
@@ -63,6 +82,7 @@ protected:
 	TArray<TSharedPtr<FFINReflectionUIEntry>> Filtered;
 
 	virtual void LoadChildren() override;
+	virtual void GetFilterableChildren(TArray<TSharedPtr<FFINReflectionUIEntry>>& OutChildren);
 
 public:
 	TArray<TSharedPtr<FFINReflectionUIEntry>> Attributes;
@@ -82,6 +102,7 @@ public:
 class FFINReflectionUIClass : public FFINReflectionUIStruct {
 protected:
 	virtual void LoadChildren() override;
+	virtual void GetFilterableChildren(TArray<TSharedPtr<FFINReflectionUIEntry>>& OutChildren) override;
 	
 public:
 	TArray<TSharedPtr<FFINReflectionUIEntry>> Signals;
@@ -89,7 +110,6 @@ public:
 	FFINReflectionUIClass(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINClass* Class, FFINReflectionUIContext* Context);
 	
 	virtual TSharedRef<SWidget> GetDetailsWidget() override;
-	virtual EFINReflectionFilterState ApplyFilter(const FFINReflectionUIFilter& Filter) override;
 
 	UFINClass* GetClass() const;
 };
@@ -99,7 +119,7 @@ private:
 	UFINProperty* Property;
 
 public:
-	FFINReflectionUIProperty(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINProperty* Property, FFINReflectionUIContext* Context) : FFINReflectionUIEntry(Parent, Context), Property(Property) {}
+	FFINReflectionUIProperty(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINProperty* Property, FFINReflectionUIContext* Context);
 	
 	virtual TSharedRef<SWidget> GetDetailsWidget() override;
 	virtual TSharedRef<SWidget> GetShortPreview() override;
@@ -117,7 +137,7 @@ protected:
 public:
 	TArray<TSharedPtr<FFINReflectionUIEntry>> Parameters;
 	
-	FFINReflectionUIFunction(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINFunction* Function, FFINReflectionUIContext* Context) : FFINReflectionUIEntry(Parent, Context), Function(Function) {}
+	FFINReflectionUIFunction(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINFunction* Function, FFINReflectionUIContext* Context);
 
 	virtual TSharedRef<SWidget> GetDetailsWidget() override;
 	virtual TSharedRef<SWidget> GetShortPreview() override;
@@ -135,7 +155,7 @@ protected:
 public:
 	TArray<TSharedPtr<FFINReflectionUIEntry>> Parameters;
 	
-	FFINReflectionUISignal(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINSignal* Signal, FFINReflectionUIContext* Context) : FFINReflectionUIEntry(Parent, Context), Signal(Signal) {}
+	FFINReflectionUISignal(const TWeakPtr<FFINReflectionUIEntry>& Parent, UFINSignal* Signal, FFINReflectionUIContext* Context);
 
 	virtual TSharedRef<SWidget> GetDetailsWidget() override;
 	virtual TSharedRef<SWidget> GetShortPreview() override;
@@ -158,6 +178,12 @@ public:
 	TArray<TSharedPtr<FFINReflectionUIEntry>> Entries;
 	TMap<UFINStruct*, TSharedPtr<FFINReflectionUIStruct>> Structs;
 	FString FilterString;
+
+	/**
+	 * False if the children of the entries got reloaded since the last filter got applied,
+	 * then the next filter can not refine the previous results.
+	 */
+	bool bFilterValid = false;
 	
 	FFINReflectionUISelectionChanged OnSelectionChanged;
 